@@ -0,0 +1,190 @@
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Context.hpp"
+#include "GEK/Utility/Timer.hpp"
+#include "GEK/Utility/JSON.hpp"
+#include <jsoncons/json.hpp>
+#include <sstream>
+
+using namespace Gek;
+
+// The conversion JSON::load used before it parsed directly, kept as the baseline to measure against
+JSON GetFromJSON(jsoncons::json const &object)
+{
+    if (object.is_empty() || object.is_null())
+    {
+        return JSON::Empty;
+    }
+
+    JSON value;
+    switch (object.type_id())
+    {
+    case jsoncons::json_type_tag::small_string_t:
+    case jsoncons::json_type_tag::string_t:
+        value = object.as_string();
+        break;
+
+    case jsoncons::json_type_tag::bool_t:
+        value = object.as_bool();
+        break;
+
+    case jsoncons::json_type_tag::double_t:
+        value = float(object.as_double());
+        break;
+
+    case jsoncons::json_type_tag::integer_t:
+        value = object.as_integer();
+        break;
+
+    case jsoncons::json_type_tag::uinteger_t:
+        value = object.as_uinteger();
+        break;
+
+    case jsoncons::json_type_tag::array_t:
+        if (true)
+        {
+            JSON::Array array;
+            array.reserve(object.size());
+            for (size_t index = 0; index < object.size(); ++index)
+            {
+                array.push_back(GetFromJSON(object[index]));
+            }
+
+            value = std::move(array);
+            break;
+        }
+
+    case jsoncons::json_type_tag::object_t:
+        if (true)
+        {
+            JSON::Object members;
+            members.reserve(object.size());
+            for (auto &pair : object.members())
+            {
+                members.append(pair.name(), GetFromJSON(pair.value()));
+            }
+
+            members.sort();
+            value = std::move(members);
+            break;
+        }
+    };
+
+    return value;
+}
+
+bool LoadWithJsonCons(std::string const &text, JSON &value)
+{
+    std::istringstream dataStream(text);
+    jsoncons::json_decoder<jsoncons::json> decoder;
+    jsoncons::json_reader reader(dataStream, decoder);
+
+    std::error_code errorCode;
+    reader.read(errorCode);
+    if (errorCode)
+    {
+        return false;
+    }
+
+    value = GetFromJSON(decoder.get_result());
+    return true;
+}
+
+// Times both readers on documents already in memory, so only parsing and tree building are measured
+void BenchmarkFile(FileSystem::Path const &filePath, uint32_t iterationCount)
+{
+    std::string text(FileSystem::Load(filePath, String::Empty));
+    if (text.empty())
+    {
+        LockedWrite{ std::cerr } << "Unable to load file: " << filePath.getString();
+        return;
+    }
+
+    JSON baselineValue;
+    JSON nativeValue;
+    if (!LoadWithJsonCons(text, baselineValue) || !nativeValue.parse(text, filePath.getString()))
+    {
+        LockedWrite{ std::cerr } << "Unable to parse file: " << filePath.getString();
+        return;
+    }
+
+    bool matched = (baselineValue.getString() == nativeValue.getString());
+
+    Timer timer;
+    for (uint32_t iteration = 0; iteration < iterationCount; ++iteration)
+    {
+        JSON value;
+        LoadWithJsonCons(text, value);
+    }
+
+    timer.update();
+    double baselineTime = (timer.getAbsoluteTime() / iterationCount);
+
+    timer.reset();
+    for (uint32_t iteration = 0; iteration < iterationCount; ++iteration)
+    {
+        JSON value;
+        value.parse(text);
+    }
+
+    timer.update();
+    double nativeTime = (timer.getAbsoluteTime() / iterationCount);
+
+    double megabytes = (double(text.size()) / (1024.0 * 1024.0));
+    LockedWrite{ std::cout } << filePath.getFileName() << ": " << text.size() << " bytes, " << (matched ? "results match" : "RESULTS DIFFER");
+    LockedWrite{ std::cout } << "> jsoncons: " << (baselineTime * 1000.0) << "ms, " << (megabytes / baselineTime) << "MB/s";
+    LockedWrite{ std::cout } << "> native: " << (nativeTime * 1000.0) << "ms, " << (megabytes / nativeTime) << "MB/s, " << (baselineTime / nativeTime) << "x";
+}
+
+int wmain(int argumentCount, wchar_t const * const argumentList[], wchar_t const * const environmentVariableList)
+{
+    LockedWrite{ std::cout } << "GEK JSON Benchmark";
+
+    uint32_t iterationCount = 100;
+    std::vector<FileSystem::Path> filePathList;
+    for (int argumentIndex = 1; argumentIndex < argumentCount; ++argumentIndex)
+    {
+        std::string argument(String::Narrow(argumentList[argumentIndex]));
+        if (argument.compare(0, 12, "-iterations:") == 0)
+        {
+            iterationCount = std::max(1U, String::Convert(argument.substr(12), 100U));
+        }
+        else
+        {
+            filePathList.push_back(argument);
+        }
+    }
+
+    // Defaults to every scene, these are the largest documents the engine loads
+    if (filePathList.empty())
+    {
+        FileSystem::Path dataPath;
+        wchar_t gekDataPath[MAX_PATH + 1] = L"\0";
+        if (GetEnvironmentVariable(L"gek_data_path", gekDataPath, MAX_PATH) > 0)
+        {
+            dataPath = String::Narrow(gekDataPath);
+        }
+        else
+        {
+            auto rootPath(FileSystem::GetModuleFilePath().getParentPath().getParentPath());
+            dataPath = FileSystem::CombinePaths(rootPath, "Data");
+        }
+
+        FileSystem::CombinePaths(dataPath, "scenes").findFiles([&](FileSystem::Path const &filePath) -> bool
+        {
+            if (filePath.isFile() && String::GetLower(filePath.getExtension()) == ".json")
+            {
+                filePathList.push_back(filePath);
+            }
+
+            return true;
+        });
+    }
+
+    for (auto const &filePath : filePathList)
+    {
+        BenchmarkFile(filePath, iterationCount);
+    }
+
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include "GEK/Utility/Context.hpp"
 #include "GEK/Utility/String.hpp"
 #include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/DerivedDataCache.hpp"
 #include <algorithm>
 #include <vector>
 
@@ -107,8 +108,9 @@ bool getMeshes(Parameters const &parameters, aiScene const *scene, aiNode const
 
 void serializeCollision(void* const serializeHandle, const void* const buffer, int size)
 {
-    FILE *file = (FILE *)serializeHandle;
-    fwrite(buffer, 1, size, file);
+    auto &outputData = *(std::vector<uint8_t> *)serializeHandle;
+    auto byteData = (uint8_t const *)buffer;
+    outputData.insert(std::end(outputData), byteData, byteData + size);
 }
 
 int wmain(int argumentCount, wchar_t const * const argumentList[], wchar_t const * const environmentVariableList)
@@ -148,6 +150,30 @@ int wmain(int argumentCount, wchar_t const * const argumentList[], wchar_t const
 		}
 	}
 
+    // Shares the engine's cache, so unchanged models are only converted once across runs and machines sharing it
+    auto rootPath(FileSystem::GetModuleFilePath().getParentPath().getParentPath());
+    DerivedDataCache derivedDataCache(FileSystem::CombinePaths(rootPath, "cache", "derived"));
+
+    FileSystem::MappedFile inputFile(fileNameInput);
+    if (inputFile.empty())
+    {
+        LockedWrite{ std::cerr } << "Unable to read input file: " << fileNameInput.getString();
+        return -__LINE__;
+    }
+
+    Header header;
+    DerivedDataCache::Key key("createhull", header.version);
+    key.addValue(header.newtonVersion).addValue(parameters.feetPerUnit).add(inputFile.data(), inputFile.size());
+    inputFile.close();
+
+    Archive::Data cachedData;
+    if (derivedDataCache.load(key, cachedData))
+    {
+        LockedWrite{ std::cout } << "Using cached convex hull for " << fileNameInput.getString();
+        FileSystem::Save(fileNameOutput, cachedData);
+        return 0;
+    }
+
 	aiLogStream logStream;
 	logStream.callback = [](char const *message, char *user) -> void
 	{
@@ -236,21 +262,20 @@ int wmain(int argumentCount, wchar_t const * const argumentList[], wchar_t const
         return -__LINE__;
     }
 
-    FILE *file = nullptr;
-    _wfopen_s(&file, fileNameOutput.getWindowsString().data(), L"wb");
-    if (file == nullptr)
+    std::vector<uint8_t> outputData(sizeof(Header));
+    std::memcpy(outputData.data(), &header, sizeof(Header));
+    NewtonCollisionSerialize(newtonWorld, newtonCollision, serializeCollision, &outputData);
+    NewtonDestroyCollision(newtonCollision);
+    NewtonDestroy(newtonWorld);
+
+    FileSystem::Save(fileNameOutput, outputData);
+    if (!fileNameOutput.isFile())
     {
         LockedWrite{ std::cerr } << "Unable to create output file";
         return -__LINE__;
     }
 
-    Header header;
-    fwrite(&header, sizeof(Header), 1, file);
-    NewtonCollisionSerialize(newtonWorld, newtonCollision, serializeCollision, file);
-    fclose(file);
-
-    NewtonDestroyCollision(newtonCollision);
-    NewtonDestroy(newtonWorld);
+    derivedDataCache.store(key, outputData);
 
     return 0;
 }
\ No newline at end of file
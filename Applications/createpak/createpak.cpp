@@ -0,0 +1,95 @@
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Archive.hpp"
+#include "GEK/Utility/String.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace Gek;
+
+int wmain(int argumentCount, wchar_t const * const argumentList[], wchar_t const * const environmentVariableList)
+{
+    LockedWrite{ std::cout } << "GEK Archive Builder";
+
+    FileSystem::Path inputPath;
+    FileSystem::Path outputPath;
+    std::vector<std::string> compressList = { ".json" };
+    for (int argumentIndex = 1; argumentIndex < argumentCount; ++argumentIndex)
+    {
+        std::string argument(String::Narrow(argumentList[argumentIndex]));
+        std::vector<std::string> arguments(String::Split(String::GetLower(argument), ':'));
+        if (arguments.empty())
+        {
+            LockedWrite{ std::cerr } << "No arguments specified for command line parameter";
+            return -__LINE__;
+        }
+
+        if (arguments[0] == "-input" && ++argumentIndex < argumentCount)
+        {
+            inputPath = String::Narrow(argumentList[argumentIndex]);
+        }
+        else if (arguments[0] == "-output" && ++argumentIndex < argumentCount)
+        {
+            outputPath = String::Narrow(argumentList[argumentIndex]);
+        }
+        else if (arguments[0] == "-compress")
+        {
+            // Extensions to deflate, with nothing after the colon to store everything uncompressed
+            compressList.clear();
+            if (arguments.size() == 2)
+            {
+                for (auto &extension : String::Split(arguments[1], ','))
+                {
+                    if (!extension.empty())
+                    {
+                        compressList.push_back(extension.front() == '.' ? extension : ("." + extension));
+                    }
+                }
+            }
+        }
+    }
+
+    if (!inputPath.isDirectory())
+    {
+        LockedWrite{ std::cerr } << "Input data directory not found: " << inputPath.getString();
+        return -__LINE__;
+    }
+
+    if (outputPath.getString().empty())
+    {
+        outputPath = inputPath.withExtension(".gekpak");
+    }
+
+    // Entry names are relative to the input directory, matching the paths passed to Context::loadDataFile
+    auto rootString(inputPath.getString());
+    uint32_t fileCount = 0;
+    Archive::Builder builder;
+    std::function<bool(FileSystem::Path const &)> addDirectory;
+    addDirectory = [&](FileSystem::Path const &filePath) -> bool
+    {
+        if (filePath.isDirectory())
+        {
+            filePath.findFiles(addDirectory);
+        }
+        else if (filePath.isFile())
+        {
+            auto name(filePath.getString().substr(rootString.size()));
+            auto extension(String::GetLower(filePath.getExtension()));
+            bool compress = (std::find(std::begin(compressList), std::end(compressList), extension) != std::end(compressList));
+            builder.addFile(name, filePath, compress ? Archive::Compression::Deflate : Archive::Compression::None);
+            ++fileCount;
+        }
+
+        return true;
+    };
+
+    inputPath.findFiles(addDirectory);
+
+    LockedWrite{ std::cout } << "Writing " << fileCount << " files to " << outputPath.getString();
+    if (!builder.write(outputPath))
+    {
+        return -__LINE__;
+    }
+
+    LockedWrite{ std::cout } << "Archive successfully created";
+    return 0;
+}
@@ -30,6 +30,16 @@ int CALLBACK wWinMain(_In_ HINSTANCE instance, _In_opt_ HINSTANCE previousInstan
         context->addDataPath(FileSystem::CombinePaths(rootPath.getString(), "data"));
         context->addDataPath(rootPath.getString());
 
+        FileSystem::CombinePaths(rootPath.getString(), "data").findFiles([&](FileSystem::Path const &filePath) -> bool
+        {
+            if (filePath.isFile() && String::GetLower(filePath.getExtension()) == ".gekpak")
+            {
+                context->mountArchive(filePath);
+            }
+
+            return true;
+        });
+
         Engine::CorePtr core(context->createClass<Engine::Core>("Engine::Core", (Window *)nullptr));
         if (core)
         {
@@ -0,0 +1,358 @@
+#include "GEK/Utility/Archive.hpp"
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/Hash.hpp"
+#include <algorithm>
+#include <iostream>
+#include <zlib.h>
+
+namespace Gek
+{
+    namespace Archive
+    {
+        namespace
+        {
+            uint64_t GetAlignedOffset(uint64_t offset, uint64_t alignment)
+            {
+                return ((offset + (alignment - 1)) & ~(alignment - 1));
+            }
+
+            bool WritePadding(FILE *file, uint64_t &offset, uint64_t alignment)
+            {
+                static const uint8_t Zero[Alignment] = { 0 };
+                auto paddingSize = size_t(GetAlignedOffset(offset, alignment) - offset);
+                offset += paddingSize;
+                return (paddingSize == 0 || fwrite(Zero, paddingSize, 1, file) == 1);
+            }
+
+            bool WriteData(FILE *file, uint64_t &offset, void const *data, size_t size)
+            {
+                offset += size;
+                return (size == 0 || fwrite(data, size, 1, file) == 1);
+            }
+        }; // namespace
+
+        std::string GetNormalizedPath(std::string_view path)
+        {
+            while (!path.empty() && (path.front() == '/' || path.front() == '\\' || (path.size() > 1 && path[0] == '.' && (path[1] == '/' || path[1] == '\\'))))
+            {
+                path.remove_prefix(path.front() == '.' ? 2 : 1);
+            }
+
+            std::string normalizedPath(path);
+            for (auto &character : normalizedPath)
+            {
+                if (character == '\\')
+                {
+                    character = '/';
+                }
+                else if (character >= 'A' && character <= 'Z')
+                {
+                    character += ('a' - 'A');
+                }
+            }
+
+            return normalizedPath;
+        }
+
+        uint64_t GetPathHash(std::string_view normalizedPath)
+        {
+            return GetStableHash(normalizedPath.data(), normalizedPath.size());
+        }
+
+        Data::Data(Data &&data)
+        {
+            *this = std::move(data);
+        }
+
+        Data &Data::operator = (Data &&data)
+        {
+            mappedFile = std::move(data.mappedFile);
+            buffer = std::move(data.buffer);
+            viewData = data.viewData;
+            viewSize = data.viewSize;
+            data.viewData = nullptr;
+            data.viewSize = 0;
+            return *this;
+        }
+
+        void Data::setView(uint8_t const *data, size_t size)
+        {
+            mappedFile.close();
+            buffer.clear();
+            viewData = data;
+            viewSize = size;
+        }
+
+        void Data::setFile(FileSystem::MappedFile &&file, size_t offset)
+        {
+            buffer.clear();
+            mappedFile = std::move(file);
+            offset = std::min(offset, mappedFile.size());
+            viewData = (mappedFile.data() + offset);
+            viewSize = (mappedFile.size() - offset);
+        }
+
+        void Data::setBuffer(std::vector<uint8_t> &&buffer)
+        {
+            mappedFile.close();
+            this->buffer = std::move(buffer);
+            viewData = this->buffer.data();
+            viewSize = this->buffer.size();
+        }
+
+        bool Reader::open(FileSystem::Path const &filePath)
+        {
+            this->filePath = filePath;
+            file = FileSystem::MappedFile(filePath);
+            header = file.getData<Header>();
+            if (!header)
+            {
+                LockedWrite{ std::cerr } << "Archive too small to contain header: " << filePath.getString();
+                return false;
+            }
+
+            if (header->identifier != Identifier || header->version != Version)
+            {
+                LockedWrite{ std::cerr } << "Unsupported archive version encountered (requires: " << Version << ", has: " << header->version << "): " << filePath.getString();
+                header = nullptr;
+                return false;
+            }
+
+            // Everything is validated once here so that lookups and reads don't need to check bounds
+            auto fileSize = file.size();
+            if (header->indexOffset > fileSize || (uint64_t(header->entryCount) * sizeof(Entry)) > (fileSize - header->indexOffset) ||
+                header->nameOffset > fileSize || header->nameSize > (fileSize - header->nameOffset))
+            {
+                LockedWrite{ std::cerr } << "Archive index extends past the end of the file: " << filePath.getString();
+                header = nullptr;
+                return false;
+            }
+
+            entryList = reinterpret_cast<Entry const *>(file.data() + header->indexOffset);
+            nameList = reinterpret_cast<char const *>(file.data() + header->nameOffset);
+            for (uint32_t entryIndex = 0; entryIndex < header->entryCount; ++entryIndex)
+            {
+                auto &entry = entryList[entryIndex];
+                if (entry.offset > fileSize || entry.size > (fileSize - entry.offset) || (uint64_t(entry.nameOffset) + entry.nameSize) > header->nameSize ||
+                    (entryIndex > 0 && entryList[entryIndex - 1].hash >= entry.hash))
+                {
+                    LockedWrite{ std::cerr } << "Archive contains an invalid entry: " << filePath.getString();
+                    header = nullptr;
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        Entry const *Reader::findEntry(std::string_view path) const
+        {
+            if (!header)
+            {
+                return nullptr;
+            }
+
+            auto normalizedPath = GetNormalizedPath(path);
+            auto hash = GetPathHash(normalizedPath);
+            auto entryEnd = (entryList + header->entryCount);
+            auto entrySearch = std::lower_bound(entryList, entryEnd, hash, [](Entry const &entry, uint64_t hash) -> bool
+            {
+                return (entry.hash < hash);
+            });
+
+            // The builder rejects colliding names, but a name that isn't in the archive can still share a hash
+            if (entrySearch != entryEnd && entrySearch->hash == hash && getName(*entrySearch) == normalizedPath)
+            {
+                return entrySearch;
+            }
+
+            return nullptr;
+        }
+
+        std::string_view Reader::getName(Entry const &entry) const
+        {
+            return std::string_view(nameList + entry.nameOffset, entry.nameSize);
+        }
+
+        bool Reader::read(Entry const &entry, Data &data) const
+        {
+            auto entryData = (file.data() + entry.offset);
+            switch (entry.compression)
+            {
+            case Compression::None:
+                data.setView(entryData, size_t(entry.size));
+                return true;
+
+            case Compression::Deflate:
+                if (true)
+                {
+                    std::vector<uint8_t> buffer(size_t(entry.uncompressedSize));
+                    uLongf bufferSize = uLongf(buffer.size());
+                    if (uncompress(buffer.data(), &bufferSize, entryData, uLong(entry.size)) != Z_OK || bufferSize != buffer.size())
+                    {
+                        LockedWrite{ std::cerr } << "Unable to decompress archive entry " << getName(entry) << ": " << filePath.getString();
+                        return false;
+                    }
+
+                    data.setBuffer(std::move(buffer));
+                    return true;
+                }
+
+            default:
+                LockedWrite{ std::cerr } << "Unknown compression used for archive entry " << getName(entry) << ": " << filePath.getString();
+                return false;
+            };
+        }
+
+        void Reader::listEntries(std::string_view directory, std::function<bool(std::string_view name)> onEntry) const
+        {
+            if (!header)
+            {
+                return;
+            }
+
+            auto prefix = GetNormalizedPath(directory);
+            if (!prefix.empty() && prefix.back() != '/')
+            {
+                prefix.push_back('/');
+            }
+
+            for (uint32_t entryIndex = 0; entryIndex < header->entryCount; ++entryIndex)
+            {
+                auto name = getName(entryList[entryIndex]);
+                if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0 && name.find('/', prefix.size()) == std::string_view::npos)
+                {
+                    if (!onEntry(name))
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+
+        void Builder::addFile(std::string_view name, FileSystem::Path const &filePath, Compression compression)
+        {
+            sourceList.push_back({ GetNormalizedPath(name), filePath, compression });
+        }
+
+        bool Builder::write(FileSystem::Path const &filePath) const
+        {
+            struct Item
+            {
+                Source const *source;
+                Entry entry;
+            };
+
+            std::vector<Item> itemList;
+            itemList.reserve(sourceList.size());
+            for (auto const &source : sourceList)
+            {
+                Item item;
+                item.source = &source;
+                item.entry.hash = GetPathHash(source.name);
+                itemList.push_back(item);
+            }
+
+            std::sort(std::begin(itemList), std::end(itemList), [](Item const &left, Item const &right) -> bool
+            {
+                return (left.entry.hash < right.entry.hash);
+            });
+
+            std::string nameList;
+            for (size_t itemIndex = 0; itemIndex < itemList.size(); ++itemIndex)
+            {
+                auto &item = itemList[itemIndex];
+                if (itemIndex > 0 && itemList[itemIndex - 1].entry.hash == item.entry.hash)
+                {
+                    auto &previousName = itemList[itemIndex - 1].source->name;
+                    LockedWrite{ std::cerr } << (previousName == item.source->name ? "Duplicate archive entry: " : "Archive entry hash collision: ") << item.source->name;
+                    return false;
+                }
+
+                if (item.source->name.size() > 0xFFFF)
+                {
+                    LockedWrite{ std::cerr } << "Archive entry name too long: " << item.source->name;
+                    return false;
+                }
+
+                item.entry.nameOffset = uint32_t(nameList.size());
+                item.entry.nameSize = uint16_t(item.source->name.size());
+                nameList.append(item.source->name);
+            }
+
+            filePath.getParentPath().createChain();
+
+            FILE *file = nullptr;
+            _wfopen_s(&file, filePath.getWindowsString().data(), L"wb");
+            if (file == nullptr)
+            {
+                LockedWrite{ std::cerr } << "Unable to create archive: " << filePath.getString();
+                return false;
+            }
+
+            // The header is written again at the end, once the index location is known
+            Header header;
+            uint64_t offset = 0;
+            bool success = WriteData(file, offset, &header, sizeof(Header));
+            for (auto &item : itemList)
+            {
+                static const std::vector<uint8_t> EmptyBuffer;
+                std::vector<uint8_t> buffer(FileSystem::Load(item.source->filePath, EmptyBuffer));
+                if (buffer.empty() && !item.source->filePath.isFile())
+                {
+                    LockedWrite{ std::cerr } << "Unable to load archive entry " << item.source->name << ": " << item.source->filePath.getString();
+                    success = false;
+                    break;
+                }
+
+                item.entry.uncompressedSize = buffer.size();
+                item.entry.compression = Compression::None;
+                if (item.source->compression == Compression::Deflate && !buffer.empty() && buffer.size() <= 0xFFFFFFFF)
+                {
+                    std::vector<uint8_t> compressedBuffer(compressBound(uLong(buffer.size())));
+                    uLongf compressedSize = uLongf(compressedBuffer.size());
+                    if (compress2(compressedBuffer.data(), &compressedSize, buffer.data(), uLong(buffer.size()), Z_BEST_COMPRESSION) == Z_OK && compressedSize < buffer.size())
+                    {
+                        compressedBuffer.resize(compressedSize);
+                        buffer = std::move(compressedBuffer);
+                        item.entry.compression = Compression::Deflate;
+                    }
+                }
+
+                success = WritePadding(file, offset, Alignment);
+                item.entry.offset = offset;
+                item.entry.size = buffer.size();
+                success = (success && WriteData(file, offset, buffer.data(), buffer.size()));
+                if (!success)
+                {
+                    break;
+                }
+            }
+
+            if (success)
+            {
+                success = WritePadding(file, offset, alignof(Entry));
+                header.entryCount = uint32_t(itemList.size());
+                header.indexOffset = offset;
+                for (auto const &item : itemList)
+                {
+                    success = (success && WriteData(file, offset, &item.entry, sizeof(Entry)));
+                }
+
+                header.nameOffset = offset;
+                header.nameSize = uint32_t(nameList.size());
+                success = (success && WriteData(file, offset, nameList.data(), nameList.size()));
+                success = (success && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(Header), 1, file) == 1);
+            }
+
+            fclose(file);
+            if (!success)
+            {
+                LockedWrite{ std::cerr } << "Unable to write archive: " << filePath.getString();
+                return false;
+            }
+
+            return true;
+        }
+    }; // namespace Archive
+}; // namespace Gek
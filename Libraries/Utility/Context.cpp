@@ -2,8 +2,14 @@
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/Context.hpp"
 #include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/IOService.hpp"
+#include "GEK/Utility/DerivedDataCache.hpp"
+#include "GEK/Utility/FileWatcher.hpp"
 #include <unordered_map>
+#include <unordered_set>
+#include <shared_mutex>
 #include <Windows.h>
+#include <atomic>
 #include <set>
 
 namespace Gek
@@ -17,13 +23,68 @@ namespace Gek
         std::unordered_multimap<std::string_view, std::string_view> typeMap;
         std::set<std::string> dataPathList;
 		std::string cachePath;
+        std::unique_ptr<DerivedDataCache> derivedDataCache;
+        std::vector<std::unique_ptr<Archive::Reader>> archiveList;
+
+        // Declared after the archives so that it stops before they're unmapped
+        std::unique_ptr<IOService> ioService;
+        std::unique_ptr<FileWatcher> fileWatcher;
 
         std::unique_ptr<Profiler> profiler;
 		Profiler::TimeFormat clockSynchronizationTime;
 
+        // Resolves paths relative to the data root to the first root containing them
+        // Directories are listed the first time something inside them is resolved, after that lookups are a hash probe
+        struct PathIndex
+        {
+            std::shared_mutex mutex;
+            std::vector<std::string> rootList;
+            std::unordered_map<std::string, std::unordered_map<std::string, std::string>> directoryMap;
+
+            void reset(std::vector<std::string> &&rootList)
+            {
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                this->rootList = std::move(rootList);
+                directoryMap.clear();
+            }
+
+            // Drops the listings containing the path, so the next lookup sees files added since
+            void invalidate(std::string_view path)
+            {
+                auto directory = Archive::GetNormalizedPath(path);
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                while (true)
+                {
+                    auto separator = directory.rfind('/');
+                    directory.resize(separator == std::string::npos ? 0 : separator);
+                    directoryMap.erase(directory);
+                    if (separator == std::string::npos)
+                    {
+                        break;
+                    }
+                };
+            }
+        };
+
+        mutable PathIndex dataPathIndex;
+        mutable PathIndex cachePathIndex;
+        mutable std::atomic<uint64_t> indexedDirectoryCount = 0;
+        mutable std::atomic<int64_t> indexTime = 0;
+        FileWatcher::ListenerHandle fileListener = 0;
+
 	public:
         ContextImplementation(std::vector<FileSystem::Path> const &pluginSearchList)
+            : ioService(std::make_unique<IOService>(this))
+            , fileWatcher(std::make_unique<FileWatcher>())
         {
+            fileListener = fileWatcher->addListener([this](std::vector<std::string> const &filePathList) -> void
+            {
+                for (auto const &filePath : filePathList)
+                {
+                    dataPathIndex.invalidate(filePath);
+                }
+            });
+
 			for (auto const &searchPath : pluginSearchList)
             {
                 searchPath.findFiles([&](FileSystem::Path const &filePath) -> bool
@@ -74,6 +135,8 @@ namespace Gek
 
         ~ContextImplementation(void)
         {
+            fileWatcher = nullptr;
+            ioService = nullptr;
             typeMap.clear();
             classMap.clear();
             for (auto const &module : moduleList)
@@ -108,6 +171,8 @@ namespace Gek
 		void setCachePath(FileSystem::Path const &path)
 		{
 			cachePath = path.getString();
+            cachePathIndex.reset({ cachePath });
+            derivedDataCache = std::make_unique<DerivedDataCache>(FileSystem::CombinePaths(cachePath, "derived"));
 		}
 
 		FileSystem::Path getCachePath(FileSystem::Path const &path)
@@ -115,14 +180,127 @@ namespace Gek
 			return FileSystem::CombinePaths(cachePath, path.getString());
 		}
 
+        void notifyCacheWrite(FileSystem::Path const &filePath)
+        {
+            // The cache isn't watched, so writers report files once they're in place
+            auto normalizedCachePath = Archive::GetNormalizedPath(cachePath);
+            auto normalizedPath = Archive::GetNormalizedPath(filePath.getString());
+            if (!normalizedCachePath.empty() && normalizedPath.size() > normalizedCachePath.size() &&
+                normalizedPath.compare(0, normalizedCachePath.size(), normalizedCachePath) == 0 &&
+                normalizedPath[normalizedCachePath.size()] == '/')
+            {
+                cachePathIndex.invalidate(std::string_view(normalizedPath).substr(normalizedCachePath.size() + 1));
+            }
+        }
+
+        DerivedDataCache *getDerivedDataCache(void) const
+        {
+            return derivedDataCache.get();
+        }
+
 		void addDataPath(FileSystem::Path const &path)
         {
-            dataPathList.insert(path.getString());
+            if (dataPathList.insert(path.getString()).second)
+            {
+                dataPathIndex.reset(std::vector<std::string>(std::begin(dataPathList), std::end(dataPathList)));
+                fileWatcher->watch(path);
+            }
+        }
+
+        bool mountArchive(FileSystem::Path const &path)
+        {
+            auto archive = std::make_unique<Archive::Reader>();
+            if (!archive->open(path))
+            {
+                LockedWrite{ std::cerr } << "Unable to mount archive: " << path.getString();
+                return false;
+            }
+
+            LockedWrite{ std::cout } << "Mounted archive: " << path.getString();
+            archiveList.push_back(std::move(archive));
+            return true;
+        }
+
+        bool resolvePath(PathIndex &pathIndex, std::string const &normalizedPath, FileSystem::Path &fullPath) const
+        {
+            auto separator = normalizedPath.rfind('/');
+            auto directory(separator == std::string::npos ? String::Empty : normalizedPath.substr(0, separator));
+            auto name(separator == std::string::npos ? normalizedPath : normalizedPath.substr(separator + 1));
+            auto findEntry = [&](std::unordered_map<std::string, std::string> const &entryMap) -> bool
+            {
+                auto entrySearch = entryMap.find(name);
+                if (entrySearch != std::end(entryMap))
+                {
+                    fullPath = entrySearch->second;
+                    return true;
+                }
+
+                return false;
+            };
+
+            std::vector<std::string> rootList;
+            if (true)
+            {
+                std::shared_lock<std::shared_mutex> lock(pathIndex.mutex);
+                auto directorySearch = pathIndex.directoryMap.find(directory);
+                if (directorySearch != std::end(pathIndex.directoryMap))
+                {
+                    return findEntry(directorySearch->second);
+                }
+
+                rootList = pathIndex.rootList;
+            }
+
+            // Earlier roots take priority, matching the order the loose data paths were searched in
+            auto startTime = Profiler::GetProfilerTime();
+            std::unordered_map<std::string, std::string> entryMap;
+            for (auto const &rootPath : rootList)
+            {
+                auto directoryPath(directory.empty() ? FileSystem::Path(rootPath) : FileSystem::CombinePaths(rootPath, directory));
+                if (directoryPath.isDirectory())
+                {
+                    directoryPath.findFiles([&](FileSystem::Path const &filePath) -> bool
+                    {
+                        entryMap.emplace(Archive::GetNormalizedPath(filePath.getFileName()), filePath.getString());
+                        return true;
+                    });
+                }
+            }
+
+            auto listingTime = (Profiler::GetProfilerTime() - startTime);
+            auto totalDirectoryCount = ++indexedDirectoryCount;
+            auto totalTime = (indexTime += listingTime.count());
+            if (profiler)
+            {
+                GEK_PROFILER_COUNTER(profiler.get(), 0, 0, "Context"sv, "Data Path Index"sv, Profiler::Arguments({ { "directories"sv, static_cast<uint32_t>(totalDirectoryCount) }, { "microseconds"sv, totalTime } }));
+            }
+
+            // Another thread may have listed the same directory meanwhile, either listing is as good
+            std::unique_lock<std::shared_mutex> lock(pathIndex.mutex);
+            return findEntry(pathIndex.directoryMap.emplace(directory, std::move(entryMap)).first->second);
         }
 
         FileSystem::Path findDataPath(FileSystem::Path const &path, bool includeCache) const
         {
             auto pathString = path.getString();
+            auto normalizedPath = Archive::GetNormalizedPath(pathString);
+            while (!normalizedPath.empty() && normalizedPath.back() == '/')
+            {
+                normalizedPath.pop_back();
+            }
+
+            if (normalizedPath.find("..") == std::string::npos && normalizedPath.find(':') == std::string::npos)
+            {
+                FileSystem::Path fullPath;
+                if ((includeCache && resolvePath(cachePathIndex, normalizedPath, fullPath)) || resolvePath(dataPathIndex, normalizedPath, fullPath))
+                {
+                    return fullPath;
+                }
+
+                return path;
+            }
+
+            // Paths outside of the data root can't be indexed, so they're checked on disk
 			if (includeCache)
 			{
 				auto fullPath = FileSystem::CombinePaths(cachePath, pathString);
@@ -144,25 +322,94 @@ namespace Gek
             return path;
         }
 
+        bool loadDataFile(FileSystem::Path const &path, Archive::Data &data, bool includeCache) const
+        {
+            Archive::Entry const *entry = nullptr;
+            auto archive = findArchiveEntry(path, entry);
+            if (archive)
+            {
+                return archive->read(*entry, data);
+            }
+
+            auto fullPath = findDataPath(path, includeCache);
+            FileSystem::MappedFile file(fullPath);
+            if (file.empty())
+            {
+                return false;
+            }
+
+            data.setFile(std::move(file));
+            return true;
+        }
+
+        Archive::Reader const *findArchiveEntry(FileSystem::Path const &path, Archive::Entry const *&entry) const
+        {
+            auto pathString = path.getString();
+            for (auto &archive : archiveList)
+            {
+                entry = archive->findEntry(pathString);
+                if (entry)
+                {
+                    return archive.get();
+                }
+            }
+
+            return nullptr;
+        }
+
+        IOService *getIOService(void) const
+        {
+            return ioService.get();
+        }
+
+        FileWatcher *getFileWatcher(void) const
+        {
+            return fileWatcher.get();
+        }
+
 		void findDataFiles(FileSystem::Path const &path, std::function<bool(FileSystem::Path const &filePath)> onFileFound, bool includeCache) const
 		{
 			auto pathString = path.getString();
+            std::unordered_set<std::string> foundSet;
+            bool searching = true;
+            auto onFound = [&](std::string_view filePath) -> bool
+            {
+                if (foundSet.insert(Archive::GetNormalizedPath(filePath)).second)
+                {
+                    searching = onFileFound(FileSystem::Path(filePath));
+                }
+
+                return searching;
+            };
+
+            for (auto &archive : archiveList)
+            {
+                archive->listEntries(pathString, onFound);
+                if (!searching)
+                {
+                    return;
+                }
+            }
+
+            auto findLooseFiles = [&](FileSystem::Path const &fullPath) -> void
+            {
+                if (searching && fullPath.isDirectory())
+                {
+                    fullPath.findFiles([&](FileSystem::Path const &filePath) -> bool
+                    {
+                        return (!filePath.isFile() || onFound(FileSystem::CombinePaths(pathString, filePath.getFileName()).getString()));
+                    });
+                }
+            };
+
 			if (includeCache)
 			{
-				auto fullPath = FileSystem::CombinePaths(cachePath, pathString);
-				if (fullPath.isDirectory())
-				{
-					fullPath.findFiles(onFileFound);
-				}
+				findLooseFiles(FileSystem::CombinePaths(cachePath, pathString));
 			}
 
 			for (auto &dataPath : dataPathList)
 			{
-				auto fullPath = FileSystem::CombinePaths(dataPath, pathString);
-				if (fullPath.isDirectory())
-				{
-					fullPath.findFiles(onFileFound);
-				}
+				findLooseFiles(FileSystem::CombinePaths(dataPath, pathString));
 			}
 		}
 
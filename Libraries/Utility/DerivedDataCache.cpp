@@ -0,0 +1,195 @@
+#include "GEK/Utility/DerivedDataCache.hpp"
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/Hash.hpp"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <atomic>
+
+namespace Gek
+{
+    namespace
+    {
+        std::experimental::filesystem::path GetPath(FileSystem::Path const &path)
+        {
+            return std::experimental::filesystem::path(path.getWindowsString());
+        }
+
+        // Temporary files belong to stores still being written, so they aren't counted or trimmed
+        bool IsEntry(std::experimental::filesystem::directory_entry const &entry)
+        {
+            return (std::experimental::filesystem::is_regular_file(entry.status()) && entry.path().extension() != ".tmp");
+        }
+    }; // namespace
+
+    DerivedDataCache::Key::Key(std::string_view toolName, uint32_t toolVersion)
+        : toolName(toolName)
+        , hash(0)
+        , checkHash(0x9E3779B97F4A7C15ULL)
+    {
+        add(toolName);
+        addValue(toolVersion);
+    }
+
+    DerivedDataCache::Key &DerivedDataCache::Key::add(void const *data, size_t size)
+    {
+        // Each input seeds the next, so the order of the inputs is part of the key
+        hash = GetStableHash(data, size, hash);
+        checkHash = GetStableHash(data, size, checkHash);
+        return *this;
+    }
+
+    uint64_t DerivedDataCache::GetHash(std::string_view data)
+    {
+        return GetStableHash(data.data(), data.size());
+    }
+
+    DerivedDataCache::DerivedDataCache(FileSystem::Path const &rootPath, uint64_t maximumSize)
+        : rootPath(rootPath)
+        , maximumSize(maximumSize)
+    {
+        std::error_code errorCode;
+        for (auto &entry : std::experimental::filesystem::recursive_directory_iterator(GetPath(rootPath), errorCode))
+        {
+            if (IsEntry(entry))
+            {
+                currentSize += std::experimental::filesystem::file_size(entry.path(), errorCode);
+            }
+        }
+
+        if (currentSize > maximumSize)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            trim();
+        }
+    }
+
+    FileSystem::Path DerivedDataCache::getEntryPath(Key const &key) const
+    {
+        char hashString[17];
+        std::snprintf(hashString, sizeof(hashString), "%016llx", static_cast<unsigned long long>(key.getHash()));
+        return FileSystem::CombinePaths(rootPath, std::string(key.getToolName()), std::string(hashString)).withExtension(".bin");
+    }
+
+    bool DerivedDataCache::load(Key const &key, Archive::Data &data)
+    {
+        auto entryPath(getEntryPath(key));
+        FileSystem::MappedFile file(entryPath);
+        auto header = file.getData<Header>();
+        if (!header)
+        {
+            return false;
+        }
+
+        // A different check hash means a collision in the file name, so it's treated as a miss and replaced on store
+        if (header->identifier != Header().identifier || header->version != Header().version || header->checkHash != key.getCheckHash() || header->size != (file.size() - sizeof(Header)))
+        {
+            return false;
+        }
+
+        data.setFile(std::move(file), sizeof(Header));
+
+        std::error_code errorCode;
+        std::experimental::filesystem::last_write_time(GetPath(entryPath), std::experimental::filesystem::file_time_type::clock::now(), errorCode);
+        return true;
+    }
+
+    bool DerivedDataCache::store(Key const &key, void const *data, size_t size)
+    {
+        static std::atomic<uint32_t> temporaryIndex = 0;
+
+        auto entryPath(getEntryPath(key));
+        entryPath.getParentPath().createChain();
+
+        // Unique per writer, so concurrent stores of the same entry don't write over each other's temporary file
+        auto temporaryPath(entryPath.withExtension(String::Format(".{}.{}.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()), temporaryIndex++)));
+
+        FILE *file = nullptr;
+        _wfopen_s(&file, temporaryPath.getWindowsString().data(), L"wb");
+        if (file == nullptr)
+        {
+            LockedWrite{ std::cerr } << "Unable to create derived data: " << temporaryPath.getString();
+            return false;
+        }
+
+        Header header;
+        header.checkHash = key.getCheckHash();
+        header.size = size;
+        bool written = (fwrite(&header, sizeof(Header), 1, file) == 1 && (size == 0 || fwrite(data, size, 1, file) == 1));
+        written = ((fclose(file) == 0) && written);
+
+        // Replacing an entry, such as one with a colliding file name, only grows the cache by the difference
+        std::error_code errorCode;
+        uint64_t previousSize = 0;
+        if (written)
+        {
+            previousSize = std::experimental::filesystem::file_size(GetPath(entryPath), errorCode);
+            if (errorCode)
+            {
+                previousSize = 0;
+            }
+
+            std::experimental::filesystem::rename(GetPath(temporaryPath), GetPath(entryPath), errorCode);
+        }
+
+        if (!written || errorCode)
+        {
+            // The entry is content addressed, so losing a rename to another writer still leaves the same data
+            std::experimental::filesystem::remove(GetPath(temporaryPath), errorCode);
+            return entryPath.isFile();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        currentSize += (sizeof(Header) + size);
+        currentSize -= std::min(previousSize, currentSize);
+        if (currentSize > maximumSize)
+        {
+            trim();
+        }
+
+        return true;
+    }
+
+    void DerivedDataCache::trim(void)
+    {
+        struct Entry
+        {
+            std::experimental::filesystem::path path;
+            std::experimental::filesystem::file_time_type lastUsedTime;
+            uint64_t size;
+        };
+
+        std::error_code errorCode;
+        std::vector<Entry> entryList;
+        currentSize = 0;
+        for (auto &entry : std::experimental::filesystem::recursive_directory_iterator(GetPath(rootPath), errorCode))
+        {
+            if (IsEntry(entry))
+            {
+                auto size = std::experimental::filesystem::file_size(entry.path(), errorCode);
+                entryList.push_back({ entry.path(), std::experimental::filesystem::last_write_time(entry.path(), errorCode), size });
+                currentSize += size;
+            }
+        }
+
+        std::sort(std::begin(entryList), std::end(entryList), [](Entry const &left, Entry const &right) -> bool
+        {
+            return (left.lastUsedTime < right.lastUsedTime);
+        });
+
+        // Trimming below the limit leaves room for new entries before the next trim
+        const uint64_t targetSize = ((maximumSize / 4) * 3);
+        for (auto &entry : entryList)
+        {
+            if (currentSize <= targetSize)
+            {
+                break;
+            }
+
+            if (std::experimental::filesystem::remove(entry.path, errorCode))
+            {
+                currentSize -= entry.size;
+            }
+        }
+    }
+}; // namespace Gek
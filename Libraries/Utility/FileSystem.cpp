@@ -1,6 +1,13 @@
 #include "GEK/Utility/FileSystem.hpp"
 #include <fstream>
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace Gek
 {
@@ -161,6 +168,163 @@ namespace Gek
             }
         }
 
+        MappedFile::MappedFile(Path const &filePath)
+        {
+#ifdef _WIN32
+            fileHandle = CreateFileW(filePath.getWindowsString().data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, (FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN), nullptr);
+            if (fileHandle == INVALID_HANDLE_VALUE)
+            {
+                fileHandle = nullptr;
+                return;
+            }
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+            {
+                close();
+                return;
+            }
+
+            mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mappingHandle)
+            {
+                close();
+                return;
+            }
+
+            mappedData = static_cast<uint8_t const *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            if (!mappedData)
+            {
+                close();
+                return;
+            }
+
+            mappedSize = size_t(fileSize.QuadPart);
+#else
+            // The mapping keeps its own reference to the file, so the descriptor is closed straight away
+            int fileDescriptor = open(filePath.getString().data(), O_RDONLY);
+            if (fileDescriptor < 0)
+            {
+                return;
+            }
+
+            struct stat fileStatus;
+            if (fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size > 0)
+            {
+                void *mapping = mmap(nullptr, size_t(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                if (mapping != MAP_FAILED)
+                {
+                    madvise(mapping, size_t(fileStatus.st_size), MADV_SEQUENTIAL);
+                    mappedData = static_cast<uint8_t const *>(mapping);
+                    mappedSize = size_t(fileStatus.st_size);
+                }
+            }
+
+            ::close(fileDescriptor);
+#endif
+        }
+
+        MappedFile::MappedFile(MappedFile &&mappedFile)
+            : fileHandle(mappedFile.fileHandle)
+            , mappingHandle(mappedFile.mappingHandle)
+            , mappedData(mappedFile.mappedData)
+            , mappedSize(mappedFile.mappedSize)
+        {
+            mappedFile.fileHandle = nullptr;
+            mappedFile.mappingHandle = nullptr;
+            mappedFile.mappedData = nullptr;
+            mappedFile.mappedSize = 0;
+        }
+
+        MappedFile::~MappedFile(void)
+        {
+            close();
+        }
+
+        MappedFile &MappedFile::operator = (MappedFile &&mappedFile)
+        {
+            if (this != &mappedFile)
+            {
+                close();
+                std::swap(fileHandle, mappedFile.fileHandle);
+                std::swap(mappingHandle, mappedFile.mappingHandle);
+                std::swap(mappedData, mappedFile.mappedData);
+                std::swap(mappedSize, mappedFile.mappedSize);
+            }
+
+            return *this;
+        }
+
+        void MappedFile::close(void)
+        {
+#ifdef _WIN32
+            if (mappedData)
+            {
+                UnmapViewOfFile(mappedData);
+            }
+
+            if (mappingHandle)
+            {
+                CloseHandle(mappingHandle);
+            }
+
+            if (fileHandle)
+            {
+                CloseHandle(fileHandle);
+            }
+#else
+            if (mappedData)
+            {
+                munmap(const_cast<uint8_t *>(mappedData), mappedSize);
+            }
+#endif
+            fileHandle = nullptr;
+            mappingHandle = nullptr;
+            mappedData = nullptr;
+            mappedSize = 0;
+        }
+
+        void MappedFile::prefetch(size_t offset, size_t size) const
+        {
+            if (offset >= mappedSize)
+            {
+                return;
+            }
+
+            size = std::min(size, (mappedSize - offset));
+#ifdef _WIN32
+            WIN32_MEMORY_RANGE_ENTRY range = { const_cast<uint8_t *>(mappedData + offset), size };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+            auto pageOffset = (offset & ~size_t(4095));
+            madvise(const_cast<uint8_t *>(mappedData + pageOffset), ((offset + size) - pageOffset), MADV_WILLNEED);
+#endif
+            // The hint only queues the reads, touching each page waits for them
+            auto pageData = reinterpret_cast<uint8_t const volatile *>(mappedData);
+            for (size_t pageOffset = offset; pageOffset < (offset + size); pageOffset += 4096)
+            {
+                pageData[pageOffset];
+            }
+        }
+
+        size_t Peek(Path const &filePath, void *buffer, size_t size)
+        {
+#ifdef _WIN32
+            FILE *file = nullptr;
+            _wfopen_s(&file, filePath.getWindowsString().data(), L"rb");
+#else
+            FILE *file = fopen(filePath.getString().data(), "rb");
+#endif
+            if (file == nullptr)
+            {
+                return 0;
+            }
+
+            auto readSize = fread(buffer, 1, size, file);
+            fclose(file);
+            return readSize;
+        }
+
         Path GetModuleFilePath(void)
         {
 #ifdef _WIN32
@@ -0,0 +1,362 @@
+#include "GEK/Utility/FileWatcher.hpp"
+#include "GEK/Utility/String.hpp"
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/inotify.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Gek
+{
+#ifdef _WIN32
+    struct FileWatcher::Watch
+    {
+        HANDLE directoryHandle = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped = {};
+
+        // Change records are DWORD aligned
+        DWORD buffer[16 * 1024];
+
+        bool read(void)
+        {
+            return (ReadDirectoryChangesW(directoryHandle, buffer, sizeof(buffer), TRUE, (FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE), nullptr, &overlapped, nullptr) != FALSE);
+        }
+    };
+
+    struct FileWatcher::Monitor
+    {
+        HANDLE wakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        std::vector<std::unique_ptr<Watch>> watchList;
+
+        ~Monitor(void)
+        {
+            for (auto &watch : watchList)
+            {
+                DWORD bytesReturned = 0;
+                CancelIoEx(watch->directoryHandle, &watch->overlapped);
+                GetOverlappedResult(watch->directoryHandle, &watch->overlapped, &bytesReturned, TRUE);
+                CloseHandle(watch->overlapped.hEvent);
+                CloseHandle(watch->directoryHandle);
+            }
+
+            CloseHandle(wakeEvent);
+        }
+    };
+#else
+    struct FileWatcher::Watch
+    {
+        FileSystem::Path directoryPath;
+        std::string relativePath;
+    };
+
+    struct FileWatcher::Monitor
+    {
+        int notifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        int wakePipe[2] = { -1, -1 };
+        std::unordered_map<int, Watch> watchMap;
+
+        Monitor(void)
+        {
+            pipe2(wakePipe, (O_NONBLOCK | O_CLOEXEC));
+        }
+
+        ~Monitor(void)
+        {
+            close(notifyHandle);
+            close(wakePipe[0]);
+            close(wakePipe[1]);
+        }
+
+        // Inotify doesn't watch recursively, so every directory in the tree gets its own watch
+        bool addDirectory(FileSystem::Path const &directoryPath, std::string const &relativePath)
+        {
+            int watchDescriptor = inotify_add_watch(notifyHandle, directoryPath.getString().data(), (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE));
+            if (watchDescriptor < 0)
+            {
+                return false;
+            }
+
+            watchMap[watchDescriptor] = Watch{ directoryPath, relativePath };
+            directoryPath.findFiles([&](FileSystem::Path const &filePath) -> bool
+            {
+                if (filePath.isDirectory())
+                {
+                    auto fileName(filePath.getFileName());
+                    addDirectory(filePath, (relativePath.empty() ? fileName : (relativePath + "/" + fileName)));
+                }
+
+                return true;
+            });
+
+            return true;
+        }
+    };
+#endif
+
+    FileWatcher::FileWatcher(void)
+        : monitor(std::make_unique<Monitor>())
+    {
+        watchThread = std::thread([this](void) -> void
+        {
+            while (true)
+            {
+                // Roots are opened here so that only this thread touches the watches
+                std::vector<FileSystem::Path> rootList;
+                if (true)
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    if (stop)
+                    {
+                        break;
+                    }
+
+                    rootList.swap(pendingRootList);
+                }
+
+                for (auto const &rootPath : rootList)
+                {
+                    openRoot(rootPath);
+                }
+
+                auto timeout = std::chrono::milliseconds::max();
+                if (!changedSet.empty())
+                {
+                    auto settledTime = (lastChangeTime + SettleTime);
+                    auto currentTime = std::chrono::steady_clock::now();
+                    if (currentTime >= settledTime)
+                    {
+                        notifyListeners();
+                        continue;
+                    }
+
+                    timeout = std::chrono::ceil<std::chrono::milliseconds>(settledTime - currentTime);
+                }
+
+                waitForChanges(timeout);
+            };
+        });
+    }
+
+    FileWatcher::~FileWatcher(void)
+    {
+        if (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stop = true;
+        }
+
+        wake();
+        watchThread.join();
+    }
+
+    void FileWatcher::watch(FileSystem::Path const &rootPath)
+    {
+        if (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            pendingRootList.push_back(rootPath);
+        }
+
+        wake();
+    }
+
+    FileWatcher::ListenerHandle FileWatcher::addListener(Listener &&listener)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto listenerHandle = nextListener++;
+        listenerMap[listenerHandle] = std::move(listener);
+        return listenerHandle;
+    }
+
+    void FileWatcher::removeListener(ListenerHandle listener)
+    {
+        // Listeners are called with the lock held, so this waits for a call in progress
+        std::unique_lock<std::mutex> lock(mutex);
+        listenerMap.erase(listener);
+    }
+
+    void FileWatcher::addChange(std::string &&filePath)
+    {
+        changedSet.insert(std::move(filePath));
+        lastChangeTime = std::chrono::steady_clock::now();
+    }
+
+    void FileWatcher::notifyListeners(void)
+    {
+        std::vector<std::string> filePathList(std::begin(changedSet), std::end(changedSet));
+        changedSet.clear();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        for (auto &listener : listenerMap)
+        {
+            listener.second(filePathList);
+        }
+    }
+
+#ifdef _WIN32
+    bool FileWatcher::openRoot(FileSystem::Path const &rootPath)
+    {
+        auto watch = std::make_unique<Watch>();
+        watch->directoryHandle = CreateFileW(rootPath.getWindowsString().data(), FILE_LIST_DIRECTORY, (FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE), nullptr, OPEN_EXISTING, (FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED), nullptr);
+        if (watch->directoryHandle == INVALID_HANDLE_VALUE)
+        {
+            LockedWrite{ std::cerr } << "Unable to watch directory: " << rootPath.getString();
+            return false;
+        }
+
+        watch->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!watch->read())
+        {
+            LockedWrite{ std::cerr } << "Unable to watch directory: " << rootPath.getString();
+            CloseHandle(watch->overlapped.hEvent);
+            CloseHandle(watch->directoryHandle);
+            return false;
+        }
+
+        monitor->watchList.push_back(std::move(watch));
+        return true;
+    }
+
+    void FileWatcher::waitForChanges(std::chrono::milliseconds timeout)
+    {
+        std::vector<HANDLE> eventList = { monitor->wakeEvent };
+        for (auto &watch : monitor->watchList)
+        {
+            eventList.push_back(watch->overlapped.hEvent);
+        }
+
+        DWORD result = WaitForMultipleObjects(static_cast<DWORD>(eventList.size()), eventList.data(), FALSE, (timeout == std::chrono::milliseconds::max() ? INFINITE : static_cast<DWORD>(timeout.count())));
+        if (result <= WAIT_OBJECT_0 || result >= (WAIT_OBJECT_0 + eventList.size()))
+        {
+            return;
+        }
+
+        auto &watch = *monitor->watchList[result - WAIT_OBJECT_0 - 1];
+        DWORD bytesReturned = 0;
+        if (GetOverlappedResult(watch.directoryHandle, &watch.overlapped, &bytesReturned, FALSE))
+        {
+            if (bytesReturned == 0)
+            {
+                LockedWrite{ std::cerr } << "File change buffer overflowed, some changes were not reported";
+            }
+
+            auto information = reinterpret_cast<FILE_NOTIFY_INFORMATION const *>(watch.buffer);
+            while (bytesReturned > 0)
+            {
+                if (information->Action != FILE_ACTION_REMOVED && information->Action != FILE_ACTION_RENAMED_OLD_NAME)
+                {
+                    addChange(String::Narrow(std::wstring_view(information->FileName, (information->FileNameLength / sizeof(wchar_t)))));
+                }
+
+                if (information->NextEntryOffset == 0)
+                {
+                    break;
+                }
+
+                information = reinterpret_cast<FILE_NOTIFY_INFORMATION const *>(reinterpret_cast<uint8_t const *>(information) + information->NextEntryOffset);
+            };
+        }
+
+        watch.read();
+    }
+
+    void FileWatcher::wake(void)
+    {
+        SetEvent(monitor->wakeEvent);
+    }
+#else
+    bool FileWatcher::openRoot(FileSystem::Path const &rootPath)
+    {
+        if (!monitor->addDirectory(rootPath, String::Empty))
+        {
+            LockedWrite{ std::cerr } << "Unable to watch directory: " << rootPath.getString();
+            return false;
+        }
+
+        return true;
+    }
+
+    void FileWatcher::waitForChanges(std::chrono::milliseconds timeout)
+    {
+        pollfd pollList[2] =
+        {
+            { monitor->notifyHandle, POLLIN, 0 },
+            { monitor->wakePipe[0], POLLIN, 0 },
+        };
+
+        if (poll(pollList, 2, (timeout == std::chrono::milliseconds::max() ? -1 : static_cast<int>(timeout.count()))) <= 0)
+        {
+            return;
+        }
+
+        if (pollList[1].revents & POLLIN)
+        {
+            char wakeData[64];
+            while (read(monitor->wakePipe[0], wakeData, sizeof(wakeData)) > 0)
+            {
+            };
+        }
+
+        if (pollList[0].revents & POLLIN)
+        {
+            alignas(inotify_event) char buffer[16 * 1024];
+            ssize_t bufferSize = 0;
+            while ((bufferSize = read(monitor->notifyHandle, buffer, sizeof(buffer))) > 0)
+            {
+                for (char const *position = buffer; position < (buffer + bufferSize); )
+                {
+                    auto event = reinterpret_cast<inotify_event const *>(position);
+                    position += (sizeof(inotify_event) + event->len);
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        LockedWrite{ std::cerr } << "File change queue overflowed, some changes were not reported";
+                        continue;
+                    }
+
+                    auto watchSearch = monitor->watchMap.find(event->wd);
+                    if (watchSearch == std::end(monitor->watchMap))
+                    {
+                        continue;
+                    }
+
+                    if (event->mask & IN_IGNORED)
+                    {
+                        monitor->watchMap.erase(watchSearch);
+                        continue;
+                    }
+
+                    if (event->len == 0)
+                    {
+                        continue;
+                    }
+
+                    // Copied since adding a directory can rehash the watch map
+                    Watch watch = watchSearch->second;
+                    std::string fileName(event->name);
+                    std::string relativePath(watch.relativePath.empty() ? fileName : (watch.relativePath + "/" + fileName));
+                    if (event->mask & IN_ISDIR)
+                    {
+                        if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                        {
+                            monitor->addDirectory(FileSystem::CombinePaths(watch.directoryPath, fileName), relativePath);
+                        }
+                    }
+                    else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                    {
+                        addChange(std::move(relativePath));
+                    }
+                }
+            };
+        }
+    }
+
+    void FileWatcher::wake(void)
+    {
+        char wakeData = 0;
+        write(monitor->wakePipe[1], &wakeData, 1);
+    }
+#endif
+}; // namespace Gek
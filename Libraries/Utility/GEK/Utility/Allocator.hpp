@@ -7,6 +7,15 @@
 /// Last Changed: $Date$
 #pragma once
 
+#include <xmmintrin.h>
+#include <stdexcept>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <mutex>
+
 namespace Gek
 {
     template <typename TYPE, std::size_t ALIGNMENT = sizeof(TYPE)>
@@ -114,4 +123,224 @@ namespace Gek
     private:
         AlignedAllocator &operator=(AlignedAllocator const &);
     };
+
+    // Fixed size block allocator, memory is reserved in slabs that are only returned all at once
+    // Threads allocate and free through their own shard of the free list, so parallel construction
+    // doesn't serialize on a single lock per type
+    class BlockPool
+    {
+    public:
+        struct Statistics
+        {
+            size_t liveCount = 0;
+            size_t liveBytes = 0;
+            size_t reservedBytes = 0;
+        };
+
+        static constexpr size_t ShardCount = 16;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        // Padded to a cache line so that threads working in neighboring shards don't contend
+        struct alignas(64) Shard
+        {
+            std::mutex mutex;
+            FreeBlock *freeList = nullptr;
+        };
+
+        const size_t blockAlignment;
+        const size_t blockSize;
+        const size_t blocksPerSlab;
+
+        Shard shardList[ShardCount];
+        std::atomic<size_t> liveCount = 0;
+
+        std::mutex slabMutex;
+        std::vector<void *> slabList;
+
+    private:
+        // Threads are assigned shards round robin on first use and keep them for every pool
+        static size_t GetShardIndex(void)
+        {
+            static std::atomic<size_t> nextShard = 0;
+            thread_local size_t shardIndex = (nextShard++ % ShardCount);
+            return shardIndex;
+        }
+
+    public:
+        BlockPool(std::size_t size, std::size_t alignment, std::size_t blocksPerSlab = 256)
+            : blockAlignment(std::max(alignment, alignof(FreeBlock)))
+            , blockSize(((std::max(size, sizeof(FreeBlock)) + blockAlignment - 1) / blockAlignment) * blockAlignment)
+            , blocksPerSlab(blocksPerSlab)
+        {
+        }
+
+        ~BlockPool(void)
+        {
+            for (auto &slab : slabList)
+            {
+                _mm_free(slab);
+            }
+        }
+
+        BlockPool(BlockPool const &) = delete;
+        BlockPool &operator = (BlockPool const &) = delete;
+
+        void *allocate(void)
+        {
+            auto &shard = shardList[GetShardIndex()];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (!shard.freeList)
+            {
+                refill(shard);
+            }
+
+            auto block = shard.freeList;
+            shard.freeList = block->next;
+            ++liveCount;
+            return block;
+        }
+
+        // Blocks go back to the freeing thread's shard, not necessarily the one they came from
+        void free(void *data)
+        {
+            if (data)
+            {
+                auto &shard = shardList[GetShardIndex()];
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto block = static_cast<FreeBlock *>(data);
+                block->next = shard.freeList;
+                shard.freeList = block;
+                --liveCount;
+            }
+        }
+
+        // Teardown, destroys every block still in use with one walk over each slab and then returns the slabs whole
+        // Blocks aren't freed one at a time, so pointers to them must be dropped without being deleted
+        template <typename FUNCTION>
+        void release(FUNCTION &&destroy)
+        {
+            std::vector<std::unique_lock<std::mutex>> shardLockList;
+            shardLockList.reserve(ShardCount);
+            for (auto &shard : shardList)
+            {
+                shardLockList.emplace_back(shard.mutex);
+            }
+
+            std::lock_guard<std::mutex> lock(slabMutex);
+            if (liveCount > 0)
+            {
+                // Free blocks are the only ones to skip, so they're sorted once instead of marking every block
+                std::vector<uint8_t const *> freeBlockList;
+                for (auto &shard : shardList)
+                {
+                    for (auto block = shard.freeList; block; block = block->next)
+                    {
+                        freeBlockList.push_back(reinterpret_cast<uint8_t const *>(block));
+                    }
+                }
+
+                std::sort(std::begin(freeBlockList), std::end(freeBlockList));
+                for (auto &slab : slabList)
+                {
+                    auto slabData = static_cast<uint8_t *>(slab);
+                    for (size_t blockIndex = 0; blockIndex < blocksPerSlab; ++blockIndex)
+                    {
+                        auto block = (slabData + (blockIndex * blockSize));
+                        if (!std::binary_search(std::begin(freeBlockList), std::end(freeBlockList), block))
+                        {
+                            destroy(static_cast<void *>(block));
+                        }
+                    }
+                }
+            }
+
+            for (auto &slab : slabList)
+            {
+                _mm_free(slab);
+            }
+
+            for (auto &shard : shardList)
+            {
+                shard.freeList = nullptr;
+            }
+
+            slabList.clear();
+            liveCount = 0;
+        }
+
+        // For trivially destructible blocks, nothing needs to run so the slabs are returned without a walk
+        void release(void)
+        {
+            std::vector<std::unique_lock<std::mutex>> shardLockList;
+            shardLockList.reserve(ShardCount);
+            for (auto &shard : shardList)
+            {
+                shardLockList.emplace_back(shard.mutex);
+                shard.freeList = nullptr;
+            }
+
+            std::lock_guard<std::mutex> lock(slabMutex);
+            for (auto &slab : slabList)
+            {
+                _mm_free(slab);
+            }
+
+            slabList.clear();
+            liveCount = 0;
+        }
+
+        Statistics getStatistics(void)
+        {
+            std::lock_guard<std::mutex> lock(slabMutex);
+
+            Statistics statistics;
+            statistics.liveCount = liveCount;
+            statistics.liveBytes = (statistics.liveCount * blockSize);
+            statistics.reservedBytes = (slabList.size() * blocksPerSlab * blockSize);
+            return statistics;
+        }
+
+    private:
+        // Called with the shard locked, other shards are only tried so two refills can't wait on each other
+        void refill(Shard &shard)
+        {
+            for (auto &otherShard : shardList)
+            {
+                if (&otherShard != &shard)
+                {
+                    std::unique_lock<std::mutex> lock(otherShard.mutex, std::try_to_lock);
+                    if (lock.owns_lock() && otherShard.freeList)
+                    {
+                        shard.freeList = otherShard.freeList;
+                        otherShard.freeList = nullptr;
+                        return;
+                    }
+                }
+            }
+
+            auto slab = static_cast<uint8_t *>(_mm_malloc(blockSize * blocksPerSlab, blockAlignment));
+            if (slab == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+
+            if (true)
+            {
+                std::lock_guard<std::mutex> lock(slabMutex);
+                slabList.push_back(slab);
+            }
+
+            for (size_t blockIndex = blocksPerSlab; blockIndex-- > 0; )
+            {
+                auto block = reinterpret_cast<FreeBlock *>(slab + (blockIndex * blockSize));
+                block->next = shard.freeList;
+                shard.freeList = block;
+            }
+        }
+    };
 }; // namespace Gek
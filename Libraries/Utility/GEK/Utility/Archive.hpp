@@ -0,0 +1,173 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/FileSystem.hpp"
+#include <functional>
+#include <string_view>
+#include <string>
+#include <vector>
+
+namespace Gek
+{
+    // Packed asset archives (.gekpak)
+    // The file is a header, the entry data with each entry aligned for direct mapping, an index of entries sorted by
+    // path hash, and a table of the entry names, all little endian
+    namespace Archive
+    {
+        static constexpr uint32_t Identifier = 0x414B4547; // GEKA
+        static constexpr uint16_t Version = 3;
+        static constexpr uint32_t Alignment = 64;
+
+        enum class Compression : uint8_t
+        {
+            None = 0,
+            Deflate,
+        };
+
+        struct Header
+        {
+            uint32_t identifier = Identifier;
+            uint16_t version = Version;
+            uint16_t alignment = Alignment;
+            uint32_t entryCount = 0;
+            uint32_t nameSize = 0;
+            uint64_t indexOffset = 0;
+            uint64_t nameOffset = 0;
+        };
+
+        struct Entry
+        {
+            uint64_t hash = 0;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint64_t uncompressedSize = 0;
+            uint32_t nameOffset = 0;
+            uint16_t nameSize = 0;
+            Compression compression = Compression::None;
+            uint8_t reserved = 0;
+        };
+
+        // Lower case with forward slashes and no leading separators, so lookups don't depend on how a path was built
+        std::string GetNormalizedPath(std::string_view path);
+
+        // Stable between runs and builds, unlike std::hash, since it's stored in the archive
+        uint64_t GetPathHash(std::string_view normalizedPath);
+
+        // Contents of a file, either pointing in to a mounted archive, mapped from a loose file, or decompressed in to
+        // an owned buffer, views in to an archive are only valid while the archive is mounted
+        class Data
+        {
+        private:
+            FileSystem::MappedFile mappedFile;
+            std::vector<uint8_t> buffer;
+            uint8_t const *viewData = nullptr;
+            size_t viewSize = 0;
+
+        public:
+            Data(void) = default;
+            Data(Data &&data);
+            Data(Data const &) = delete;
+
+            Data &operator = (Data &&data);
+            Data &operator = (Data const &) = delete;
+
+            void setView(uint8_t const *data, size_t size);
+            // Views the mapping from the offset to the end of the file
+            void setFile(FileSystem::MappedFile &&file, size_t offset = 0);
+            void setBuffer(std::vector<uint8_t> &&buffer);
+
+            uint8_t const *data(void) const
+            {
+                return viewData;
+            }
+
+            size_t size(void) const
+            {
+                return viewSize;
+            }
+
+            bool empty(void) const
+            {
+                return (viewSize == 0);
+            }
+
+            uint8_t const *begin(void) const
+            {
+                return viewData;
+            }
+
+            uint8_t const *end(void) const
+            {
+                return (viewData + viewSize);
+            }
+
+            std::string_view getString(void) const
+            {
+                return std::string_view(reinterpret_cast<char const *>(viewData), viewSize);
+            }
+
+            // Null if the data is too small to hold a TYPE at the offset
+            template <typename TYPE>
+            TYPE const *getData(size_t offset = 0) const
+            {
+                return ((offset + sizeof(TYPE)) <= viewSize ? reinterpret_cast<TYPE const *>(viewData + offset) : nullptr);
+            }
+        };
+
+        class Reader
+        {
+        private:
+            FileSystem::Path filePath;
+            FileSystem::MappedFile file;
+            Header const *header = nullptr;
+            Entry const *entryList = nullptr;
+            char const *nameList = nullptr;
+
+        public:
+            bool open(FileSystem::Path const &filePath);
+
+            FileSystem::Path const &getPath(void) const
+            {
+                return filePath;
+            }
+
+            // The path is normalized before it's hashed
+            Entry const *findEntry(std::string_view path) const;
+            std::string_view getName(Entry const &entry) const;
+            bool read(Entry const &entry, Data &data) const;
+
+            // Faults in a range of entry data ahead of reads, see FileSystem::MappedFile::prefetch
+            void prefetch(uint64_t offset, uint64_t size) const
+            {
+                file.prefetch(size_t(offset), size_t(size));
+            }
+
+            // Calls onEntry with the name of each entry directly inside the directory, in index order
+            void listEntries(std::string_view directory, std::function<bool(std::string_view name)> onEntry) const;
+        };
+
+        class Builder
+        {
+        private:
+            struct Source
+            {
+                std::string name;
+                FileSystem::Path filePath;
+                Compression compression;
+            };
+
+            std::vector<Source> sourceList;
+
+        public:
+            // Compressed entries are stored uncompressed if compression doesn't make them smaller
+            void addFile(std::string_view name, FileSystem::Path const &filePath, Compression compression = Compression::None);
+            bool write(FileSystem::Path const &filePath) const;
+        };
+    }; // namespace Archive
+}; // namespace Gek
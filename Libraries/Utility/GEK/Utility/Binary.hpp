@@ -0,0 +1,175 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include <unordered_map>
+#include <type_traits>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Gek
+{
+    // Strings are stored once per file and referenced by index
+    class BinaryStringTable
+    {
+    private:
+        std::unordered_map<std::string, uint32_t> indexMap;
+        std::vector<std::string_view> stringList;
+
+    public:
+        uint32_t insert(std::string_view string)
+        {
+            auto insertSearch = indexMap.insert(std::make_pair(std::string(string), uint32_t(stringList.size())));
+            if (insertSearch.second)
+            {
+                stringList.push_back(insertSearch.first->first);
+            }
+
+            return insertSearch.first->second;
+        }
+
+        std::vector<std::string_view> const &getStringList(void) const
+        {
+            return stringList;
+        }
+    };
+
+    class BinaryWriter
+    {
+    private:
+        std::vector<uint8_t> &buffer;
+        BinaryStringTable &stringTable;
+
+    public:
+        BinaryWriter(std::vector<uint8_t> &buffer, BinaryStringTable &stringTable)
+            : buffer(buffer)
+            , stringTable(stringTable)
+        {
+        }
+
+        size_t getPosition(void) const
+        {
+            return buffer.size();
+        }
+
+        void write(void const *data, size_t size)
+        {
+            auto position = buffer.size();
+            buffer.resize(position + size);
+            std::memcpy(&buffer[position], data, size);
+        }
+
+        template <typename TYPE>
+        void write(TYPE const &value)
+        {
+            static_assert(std::is_trivially_copyable<TYPE>::value, "Only trivially copyable types can be written directly");
+            write(&value, sizeof(TYPE));
+        }
+
+        template <typename TYPE>
+        void overwrite(size_t position, TYPE const &value)
+        {
+            static_assert(std::is_trivially_copyable<TYPE>::value, "Only trivially copyable types can be written directly");
+            std::memcpy(&buffer[position], &value, sizeof(TYPE));
+        }
+
+        void writeString(std::string_view string)
+        {
+            write(stringTable.insert(string));
+        }
+    };
+
+    // Reads from an externally owned buffer, strings are views in to that buffer
+    // Reading past the end leaves values untouched and marks the reader invalid
+    class BinaryReader
+    {
+    private:
+        uint8_t const *current = nullptr;
+        uint8_t const *end = nullptr;
+        std::vector<std::string_view> const *stringList = nullptr;
+        bool valid = true;
+
+    public:
+        BinaryReader(void const *data, size_t size, std::vector<std::string_view> const *stringList = nullptr)
+            : current(static_cast<uint8_t const *>(data))
+            , end(static_cast<uint8_t const *>(data) + size)
+            , stringList(stringList)
+        {
+        }
+
+        bool isValid(void) const
+        {
+            return valid;
+        }
+
+        size_t getRemaining(void) const
+        {
+            return size_t(end - current);
+        }
+
+        uint8_t const *getCurrent(void) const
+        {
+            return current;
+        }
+
+        bool skip(size_t size)
+        {
+            if (!valid || getRemaining() < size)
+            {
+                valid = false;
+                return false;
+            }
+
+            current += size;
+            return true;
+        }
+
+        bool read(void *data, size_t size)
+        {
+            if (!valid || getRemaining() < size)
+            {
+                valid = false;
+                return false;
+            }
+
+            std::memcpy(data, current, size);
+            current += size;
+            return true;
+        }
+
+        template <typename TYPE>
+        bool read(TYPE &value)
+        {
+            static_assert(std::is_trivially_copyable<TYPE>::value, "Only trivially copyable types can be read directly");
+            return read(&value, sizeof(TYPE));
+        }
+
+        template <typename TYPE>
+        TYPE read(TYPE const &defaultValue = TYPE())
+        {
+            TYPE value(defaultValue);
+            read(value);
+            return value;
+        }
+
+        std::string_view readString(void)
+        {
+            uint32_t index = 0;
+            if (read(index) && stringList && index < stringList->size())
+            {
+                return stringList->at(index);
+            }
+
+            valid = false;
+            return std::string_view();
+        }
+    };
+}; // namespace Gek
@@ -9,6 +9,7 @@
 
 #include "GEK/Utility/String.hpp"
 #include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Archive.hpp"
 #include "GEK/Utility/Profiler.hpp"
 #include "GEK/Utility/Hash.hpp"
 #include <functional>
@@ -23,6 +24,9 @@
 namespace Gek
 {
     GEK_PREDECLARE(ContextUser);
+    class IOService;
+    class DerivedDataCache;
+    class FileWatcher;
 
     GEK_INTERFACE(Context)
     {
@@ -39,8 +43,35 @@ namespace Gek
 		virtual void setCachePath(FileSystem::Path const &path) = 0;
 		virtual FileSystem::Path getCachePath(FileSystem::Path const &path) = 0;
 
+        // Called with a path from getCachePath once the file has been written, so lookups that include the cache see it
+        virtual void notifyCacheWrite(FileSystem::Path const &filePath) = 0;
+
+        // Shared by every program using the same cache path, null until the cache path has been set
+        virtual DerivedDataCache *getDerivedDataCache(void) const = 0;
+
         virtual void addDataPath(FileSystem::Path const &path) = 0;
+
+        // Mounted archives are searched in mount order, before any of the loose data paths
+        virtual bool mountArchive(FileSystem::Path const &path) = 0;
+
+        // Only searches loose data paths, use loadDataFile for files that may be in a mounted archive
+        // Resolved through an index of the data paths that's kept current by the file watcher
         virtual FileSystem::Path findDataPath(FileSystem::Path const &path, bool includeCache = true) const = 0;
+
+        // Files in a mounted archive hide loose files with the same path
+        virtual bool loadDataFile(FileSystem::Path const &path, Archive::Data &data, bool includeCache = true) const = 0;
+
+        // Returns the first mounted archive containing the path, or null if it's only available as a loose file
+        virtual Archive::Reader const *findArchiveEntry(FileSystem::Path const &path, Archive::Entry const *&entry) const = 0;
+
+        // Asynchronous counterpart of loadDataFile
+        virtual IOService *getIOService(void) const = 0;
+
+        // Reports changes to loose files in the data paths, as paths relative to the data root
+        virtual FileWatcher *getFileWatcher(void) const = 0;
+
+        // Lists the files directly inside a data directory, across mounted archives and loose data paths
+        // Paths are relative to the data root so they can be passed to loadDataFile, and each is only listed once
 		virtual void findDataFiles(FileSystem::Path const &path, std::function<bool(FileSystem::Path const &filePath)> onFileFound, bool includeCache = true) const = 0;
 
         virtual ContextUserPtr createBaseClass(std::string_view className, void *typelessArguments, std::vector<Hash> &argumentTypes) const = 0;
@@ -0,0 +1,110 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Archive.hpp"
+#include <string_view>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace Gek
+{
+    // Stores the output of converters and compilers under a hash of everything that produced it, so a result is
+    // reused for as long as its inputs and the tool are unchanged, no matter which run or which program made it
+    class DerivedDataCache
+    {
+    public:
+        static constexpr uint64_t DefaultMaximumSize = (1024ULL * 1024ULL * 1024ULL);
+
+        // Every input that affects the output has to be added, including the tool version, which must change
+        // whenever the tool's output would
+        class Key
+        {
+        private:
+            std::string toolName;
+            uint64_t hash;
+
+            // Chained from a different seed and stored in the entry, so a collision in the file name is caught on load
+            uint64_t checkHash;
+
+        public:
+            Key(std::string_view toolName, uint32_t toolVersion);
+
+            Key &add(void const *data, size_t size);
+
+            Key &add(std::string_view data)
+            {
+                // The length keeps neighbouring strings from hashing the same as one joined string
+                return addValue(static_cast<uint64_t>(data.size())).add(data.data(), data.size());
+            }
+
+            template <typename TYPE>
+            Key &addValue(TYPE const &value)
+            {
+                static_assert(std::is_trivially_copyable<TYPE>::value, "Only plain values can be added directly");
+                return add(&value, sizeof(TYPE));
+            }
+
+            std::string_view getToolName(void) const
+            {
+                return toolName;
+            }
+
+            uint64_t getHash(void) const
+            {
+                return hash;
+            }
+
+            uint64_t getCheckHash(void) const
+            {
+                return checkHash;
+            }
+        };
+
+        // Stable between runs, for recording the inputs that are only known once the tool has run
+        static uint64_t GetHash(std::string_view data);
+
+    private:
+        struct Header
+        {
+            uint32_t identifier = 0x444B4547; // GEKD
+            uint16_t version = 3;
+            uint16_t reserved = 0;
+            uint64_t checkHash = 0;
+            uint64_t size = 0;
+        };
+
+        FileSystem::Path rootPath;
+        uint64_t maximumSize;
+
+        std::mutex mutex;
+        uint64_t currentSize = 0;
+
+    private:
+        FileSystem::Path getEntryPath(Key const &key) const;
+        void trim(void);
+
+    public:
+        DerivedDataCache(FileSystem::Path const &rootPath, uint64_t maximumSize = DefaultMaximumSize);
+
+        // Marks the entry as recently used, so it's the last to be trimmed
+        // The data views the mapped entry, it's never copied out of the file
+        bool load(Key const &key, Archive::Data &data);
+
+        // Written to a temporary file and renamed in to place, so readers never see a partial entry
+        bool store(Key const &key, void const *data, size_t size);
+
+        template <typename CONTAINER>
+        bool store(Key const &key, CONTAINER const &data)
+        {
+            return store(key, data.data(), (data.size() * sizeof(*data.data())));
+        }
+    };
+}; // namespace Gek
@@ -66,6 +66,79 @@ namespace Gek
         {
         };
 
+        // A read-only view of a whole file mapped in to memory, the data stays valid for the lifetime of the view
+        // Empty if the file doesn't exist, is empty, or can't be mapped
+        class MappedFile
+        {
+        private:
+            void *fileHandle = nullptr;
+            void *mappingHandle = nullptr;
+            uint8_t const *mappedData = nullptr;
+            size_t mappedSize = 0;
+
+        public:
+            MappedFile(void) = default;
+            MappedFile(Path const &filePath);
+            MappedFile(MappedFile &&mappedFile);
+            MappedFile(MappedFile const &) = delete;
+            ~MappedFile(void);
+
+            MappedFile &operator = (MappedFile &&mappedFile);
+            MappedFile &operator = (MappedFile const &) = delete;
+
+            void close(void);
+
+            // Faults the range in on the calling thread, so later reads of it don't wait on the disk
+            void prefetch(size_t offset, size_t size) const;
+
+            uint8_t const *data(void) const
+            {
+                return mappedData;
+            }
+
+            size_t size(void) const
+            {
+                return mappedSize;
+            }
+
+            bool empty(void) const
+            {
+                return (mappedSize == 0);
+            }
+
+            uint8_t const *begin(void) const
+            {
+                return mappedData;
+            }
+
+            uint8_t const *end(void) const
+            {
+                return (mappedData + mappedSize);
+            }
+
+            std::string_view getString(void) const
+            {
+                return std::string_view(reinterpret_cast<char const *>(mappedData), mappedSize);
+            }
+
+            // Null if the file is too small to hold a TYPE at the offset
+            template <typename TYPE>
+            TYPE const *getData(size_t offset = 0) const
+            {
+                return ((offset + sizeof(TYPE)) <= mappedSize ? reinterpret_cast<TYPE const *>(mappedData + offset) : nullptr);
+            }
+        };
+
+        // Reads up to size bytes from the start of the file without loading the rest, returns the number of bytes read
+        size_t Peek(Path const &filePath, void *buffer, size_t size);
+
+        // False if the file is too small to hold the header
+        template <typename TYPE>
+        bool PeekHeader(Path const &filePath, TYPE &header)
+        {
+            return (Peek(filePath, &header, sizeof(TYPE)) == sizeof(TYPE));
+        }
+
 		Path GetModuleFilePath(void);
 
         template <typename... PARAMETERS>
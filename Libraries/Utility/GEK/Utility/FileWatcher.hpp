@@ -0,0 +1,73 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/FileSystem.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <memory>
+
+namespace Gek
+{
+    // Watches directory trees on a dedicated thread and reports the files written in them
+    class FileWatcher
+    {
+    public:
+        // Paths are relative to the watched directory they were found in
+        // Called on the watcher thread, so listeners should only hand the work off
+        using Listener = std::function<void(std::vector<std::string> const &filePathList)>;
+        using ListenerHandle = uint64_t;
+
+        // Editors often write a file more than once per save, so changes are held until they've settled
+        static constexpr std::chrono::milliseconds SettleTime = std::chrono::milliseconds(200);
+
+    private:
+        struct Watch;
+        struct Monitor;
+
+        std::unique_ptr<Monitor> monitor;
+
+        std::mutex mutex;
+        std::vector<FileSystem::Path> pendingRootList;
+        std::unordered_map<ListenerHandle, Listener> listenerMap;
+        ListenerHandle nextListener = 1;
+        bool stop = false;
+
+        std::unordered_set<std::string> changedSet;
+        std::chrono::steady_clock::time_point lastChangeTime;
+        std::thread watchThread;
+
+    private:
+        bool openRoot(FileSystem::Path const &rootPath);
+        void waitForChanges(std::chrono::milliseconds timeout);
+        void wake(void);
+
+        void addChange(std::string &&filePath);
+        void notifyListeners(void);
+
+    public:
+        FileWatcher(void);
+        ~FileWatcher(void);
+
+        FileWatcher(FileWatcher const &) = delete;
+        FileWatcher &operator = (FileWatcher const &) = delete;
+
+        // Watches the directory and everything below it
+        void watch(FileSystem::Path const &rootPath);
+
+        ListenerHandle addListener(Listener &&listener);
+
+        // Once this returns the listener is no longer being called
+        void removeListener(ListenerHandle listener);
+    };
+}; // namespace Gek
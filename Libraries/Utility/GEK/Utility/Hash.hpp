@@ -7,16 +7,180 @@
 /// Last Changed: $Date$
 #pragma once
 
+#include <string_view>
 #include <functional>
+#include <cstdint>
 #include <string>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// Lets constexpr functions take a faster path when they're called at run time, C++17 has no standard way to tell
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define GEK_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#if !defined(GEK_IS_CONSTANT_EVALUATED) && ((defined(_MSC_VER) && _MSC_VER >= 1925) || (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9))
+#define GEK_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
 
 namespace Gek
 {
     using Hash = std::size_t;
 
+    // Based on wyhash, the same on every run, compiler and platform, so it's safe to store in files
+    namespace StableHash
+    {
+        static constexpr uint64_t Secret[4] = { 0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL, 0x4B33A62ED433D4A3ULL, 0x4D5A2DA51DE1AA47ULL };
+
+        // Full 128 bit product, returned as the low half in left and the high half in right
+        template <bool CONSTANT>
+        constexpr void Multiply(uint64_t &left, uint64_t &right)
+        {
+#if defined(_MSC_VER) && defined(_M_X64)
+            if constexpr (!CONSTANT)
+            {
+                left = _umul128(left, right, &right);
+            }
+            else
+#elif defined(__SIZEOF_INT128__)
+            if constexpr (!CONSTANT)
+            {
+                auto product = (static_cast<unsigned __int128>(left) * right);
+                left = static_cast<uint64_t>(product);
+                right = static_cast<uint64_t>(product >> 64);
+            }
+            else
+#endif
+            {
+                uint64_t leftHigh = (left >> 32), leftLow = static_cast<uint32_t>(left);
+                uint64_t rightHigh = (right >> 32), rightLow = static_cast<uint32_t>(right);
+                uint64_t high = (leftHigh * rightHigh), middleLeft = (leftHigh * rightLow), middleRight = (rightHigh * leftLow), low = (leftLow * rightLow);
+                uint64_t partial = (low + (middleLeft << 32));
+                uint64_t carry = (partial < low);
+                uint64_t result = (partial + (middleRight << 32));
+                carry += (result < partial);
+                left = result;
+                right = (high + (middleLeft >> 32) + (middleRight >> 32) + carry);
+            }
+        }
+
+        template <bool CONSTANT>
+        constexpr uint64_t Mix(uint64_t left, uint64_t right)
+        {
+            Multiply<CONSTANT>(left, right);
+            return (left ^ right);
+        }
+
+        // Little endian regardless of the platform, assembled from bytes so it also works at compile time
+        constexpr uint64_t Read(char const *data, size_t size)
+        {
+            uint64_t value = 0;
+            for (size_t index = 0; index < size; ++index)
+            {
+                value |= (static_cast<uint64_t>(static_cast<uint8_t>(data[index])) << (index * 8));
+            }
+
+            return value;
+        }
+
+        template <bool CONSTANT>
+        constexpr uint64_t Calculate(char const *data, size_t size, uint64_t seed)
+        {
+            seed ^= Mix<CONSTANT>(seed ^ Secret[0], Secret[1]);
+
+            uint64_t left = 0, right = 0;
+            if (size <= 16)
+            {
+                if (size >= 4)
+                {
+                    auto offset = ((size >> 3) << 2);
+                    left = ((Read(data, 4) << 32) | Read(data + offset, 4));
+                    right = ((Read(data + size - 4, 4) << 32) | Read(data + size - 4 - offset, 4));
+                }
+                else if (size > 0)
+                {
+                    left = ((static_cast<uint64_t>(static_cast<uint8_t>(data[0])) << 16) | (static_cast<uint64_t>(static_cast<uint8_t>(data[size >> 1])) << 8) | static_cast<uint8_t>(data[size - 1]));
+                }
+            }
+            else
+            {
+                auto remaining = size;
+                if (remaining > 48)
+                {
+                    auto firstSeed = seed, secondSeed = seed;
+                    do
+                    {
+                        seed = Mix<CONSTANT>(Read(data, 8) ^ Secret[1], Read(data + 8, 8) ^ seed);
+                        firstSeed = Mix<CONSTANT>(Read(data + 16, 8) ^ Secret[2], Read(data + 24, 8) ^ firstSeed);
+                        secondSeed = Mix<CONSTANT>(Read(data + 32, 8) ^ Secret[3], Read(data + 40, 8) ^ secondSeed);
+                        data += 48;
+                        remaining -= 48;
+                    } while (remaining > 48);
+
+                    seed ^= (firstSeed ^ secondSeed);
+                }
+
+                while (remaining > 16)
+                {
+                    seed = Mix<CONSTANT>(Read(data, 8) ^ Secret[1], Read(data + 8, 8) ^ seed);
+                    data += 16;
+                    remaining -= 16;
+                };
+
+                left = Read(data + remaining - 16, 8);
+                right = Read(data + remaining - 8, 8);
+            }
+
+            left ^= Secret[1];
+            right ^= seed;
+            Multiply<CONSTANT>(left, right);
+            return Mix<CONSTANT>(left ^ Secret[0] ^ size, right ^ Secret[1]);
+        }
+    }; // namespace StableHash
+
+    // Usable at compile time, so identifiers can be hashed from string literals
+    // Both paths give the same value, the portable multiply is only used when evaluated by the compiler
+    constexpr uint64_t GetStableHash(std::string_view data, uint64_t seed = 0)
+    {
+#ifdef GEK_IS_CONSTANT_EVALUATED
+        if (!GEK_IS_CONSTANT_EVALUATED())
+        {
+            return StableHash::Calculate<false>(data.data(), data.size(), seed);
+        }
+#endif
+        return StableHash::Calculate<true>(data.data(), data.size(), seed);
+    }
+
+    // Chaining the result in as the next seed hashes several inputs as one key
+    inline uint64_t GetStableHash(void const *data, size_t size, uint64_t seed = 0)
+    {
+        return StableHash::Calculate<false>(static_cast<char const *>(data), size, seed);
+    }
+
+    // Hashed as one sixteen byte input, a single multiply of the two would be zero whenever either equals its secret
     inline Hash CombineHashes(Hash upper, Hash lower)
     {
-        return upper ^ (lower + 0x9e3779b9 + (upper << 6) + (upper >> 2));
+        uint64_t const valueList[2] = { upper, lower };
+        return StableHash::Calculate<false>(reinterpret_cast<char const *>(valueList), sizeof(valueList), 0);
+    }
+
+    template <typename TYPE>
+    Hash GetValueHash(TYPE const &value)
+    {
+        return std::hash<TYPE>()(value);
+    }
+
+    // Strings are hashed with the stable hash, std::hash is implementation defined
+    inline Hash GetValueHash(std::string_view value)
+    {
+        return GetStableHash(value.data(), value.size());
+    }
+
+    inline Hash GetValueHash(std::string const &value)
+    {
+        return GetStableHash(value.data(), value.size());
     }
 
     inline Hash GetHash(void)
@@ -27,7 +191,7 @@ namespace Gek
     template <typename TYPE, typename... PARAMETERS>
     Hash GetHash(TYPE const &value, PARAMETERS const &... arguments)
     {
-        Hash seed = std::hash<TYPE>()(value);
+        Hash seed = GetValueHash(value);
         Hash remainder = GetHash(arguments...);
         return CombineHashes(seed, remainder);
     }
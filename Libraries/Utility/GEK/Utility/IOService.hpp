@@ -0,0 +1,89 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Archive.hpp"
+#include <condition_variable>
+#include <unordered_map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <vector>
+
+namespace Gek
+{
+    struct Context;
+
+    // Reads data files on a dedicated thread so that loaders don't block worker threads waiting on the disk
+    // Pending reads from the same archive are merged in to single reads of each run of neighbouring entries
+    class IOService
+    {
+    public:
+        enum class Priority : uint8_t
+        {
+            Background = 0,
+            Normal,
+            Immediate,
+        };
+
+        using Request = uint64_t;
+        static constexpr Request InvalidRequest = 0;
+
+        // Data is empty if the file couldn't be read
+        using Callback = std::function<void(Archive::Data &&data)>;
+
+        // Runs the completion, so decompression and parsing happen on the caller's own workers
+        // Without one, completions run on the I/O thread and should only hand the data off
+        using Dispatch = std::function<void(std::function<void(void)> &&task)>;
+
+        // Runs of archive entries closer together than this are read as a single range
+        static constexpr uint64_t CoalesceGapSize = (64 * 1024);
+        static constexpr uint64_t MaximumCoalesceSize = (16 * 1024 * 1024);
+
+    private:
+        struct Item
+        {
+            Request request;
+            Priority priority;
+            FileSystem::Path path;
+            bool includeCache;
+            Archive::Reader const *archive;
+            Archive::Entry const *entry;
+            Callback onLoaded;
+            Dispatch dispatch;
+        };
+
+        Context const *context = nullptr;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::unordered_map<Request, Item> itemMap;
+        std::vector<Request> pendingList;
+        Request nextRequest = 1;
+        bool stop = false;
+        std::thread ioThread;
+
+    private:
+        bool getNextBatch(std::vector<Item> &batch);
+        void readBatch(std::vector<Item> &batch);
+        bool complete(Item &item, std::function<void(void)> &&task);
+
+    public:
+        IOService(Context const *context);
+        ~IOService(void);
+
+        IOService(IOService const &) = delete;
+        IOService &operator = (IOService const &) = delete;
+
+        Request read(FileSystem::Path const &path, Priority priority, Callback &&onLoaded, Dispatch &&dispatch = nullptr, bool includeCache = true);
+
+        // Returns true if the callback will never be called, false if it has already been dispatched
+        bool cancel(Request request);
+    };
+}; // namespace Gek
@@ -15,8 +15,11 @@
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/ShuntingYard.hpp"
 #include <type_traits>
+#include <string_view>
 #include <functional>
 #include <variant>
+#include <utility>
+#include <vector>
 
 namespace Gek
 {
@@ -78,11 +81,81 @@ namespace Gek
         using FUNCTION::operator();
     };
 
+    class JSONWriter;
+
     class JSON
     {
     public:
         using Array = std::vector<JSON>;
-        using Object = std::unordered_map<std::string, JSON>;
+
+        // Members are kept in one small array sorted by name and found with a binary search on the name,
+        // so lookups never build a key string and each object is a single allocation
+        // Like a vector, adding or erasing members can move the other members
+        class Object
+        {
+        public:
+            using value_type = std::pair<std::string, JSON>;
+            using iterator = std::vector<value_type>::iterator;
+            using const_iterator = std::vector<value_type>::const_iterator;
+
+        private:
+            std::vector<value_type> memberList;
+
+        public:
+            iterator begin(void)
+            {
+                return memberList.begin();
+            }
+
+            iterator end(void)
+            {
+                return memberList.end();
+            }
+
+            const_iterator begin(void) const
+            {
+                return memberList.begin();
+            }
+
+            const_iterator end(void) const
+            {
+                return memberList.end();
+            }
+
+            size_t size(void) const
+            {
+                return memberList.size();
+            }
+
+            bool empty(void) const
+            {
+                return memberList.empty();
+            }
+
+            void clear(void)
+            {
+                memberList.clear();
+            }
+
+            void reserve(size_t size)
+            {
+                memberList.reserve(size);
+            }
+
+            iterator find(std::string_view name);
+            const_iterator find(std::string_view name) const;
+            size_t count(std::string_view name) const;
+            JSON &operator [] (std::string_view name);
+
+            std::pair<iterator, bool> insert(value_type &&member);
+            iterator erase(const_iterator position);
+            size_t erase(std::string_view name);
+
+            // Appends without ordering for bulk loading, sort must be called once all members are added
+            // Later members replace earlier members with the same name
+            void append(std::string_view name, JSON &&value);
+            void sort(void);
+        };
 
         static const Array EmptyArray;
         static const Object EmptyObject;
@@ -101,16 +174,37 @@ namespace Gek
         {
         }
 
+        JSON(JSON &&node) = default;
+
         template <typename TYPE>
         JSON(TYPE newData)
-            : data(newData)
+            : data(std::move(newData))
         {
         }
 
+        JSON &operator = (JSON const &node) = default;
+        JSON &operator = (JSON &&node) = default;
+
+        // Parses a complete document from memory, errors are logged with their line and column in sourceName
+        // The current value is left unchanged if the document is invalid
+        bool parse(std::string_view text, std::string_view sourceName = std::string_view());
+
+        // Called with the root read so far and each element of the streamed array as soon as it has been read
+        using StreamCallback = std::function<bool(JSON const &root, JSON &&element)>;
+
+        // Like parse, but elements of the root object's streamName array are passed to onStreamElement instead of
+        // being stored, so only one element is held at a time, returning false stops the parse
+        // Members of the root are only visible to the callback if they come before the array in the document
+        bool parse(std::string_view text, std::string_view sourceName, std::string_view streamName, StreamCallback const &onStreamElement);
+
         void load(FileSystem::Path const &filePath);
-        void save(FileSystem::Path const &filePath);
 
-        std::string getString(void) const;
+        // Written through a small buffer straight to the file
+        void save(FileSystem::Path const &filePath, bool pretty = true) const;
+
+        void write(JSONWriter &writer) const;
+
+        std::string getString(bool pretty = false) const;
 
         template <class... FUNCTIONS>
         auto visit(FUNCTIONS&&... functions)
@@ -141,6 +235,19 @@ namespace Gek
             return defaultValue;
         }
 
+        // Containers are returned by reference so walking a document doesn't copy it
+        Array const &asType(Array const &defaultValue) const
+        {
+            auto value = std::get_if<Array>(&data);
+            return (value ? *value : defaultValue);
+        }
+
+        Object const &asType(Object const &defaultValue) const
+        {
+            auto value = std::get_if<Object>(&data);
+            return (value ? *value : defaultValue);
+        }
+
         template <typename TYPE>
         TYPE &makeType(void)
         {
@@ -195,6 +302,9 @@ namespace Gek
         Math::Float4 evaluate(ShuntingYard &shuntingYard, Math::Float4 const &defaultValue) const;
         Math::Quaternion evaluate(ShuntingYard &shuntingYard, Math::Quaternion const &defaultValue) const;
         std::string evaluate(ShuntingYard &shuntingYard, std::string const &defaultValue) const;
+
+        // True if evaluating any string in this node, or its children, always produces the same value
+        bool isDeterministic(ShuntingYard &shuntingYard) const;
     };
 }; // namespace Gek
 
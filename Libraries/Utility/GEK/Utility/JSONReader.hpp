@@ -0,0 +1,71 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <string>
+
+namespace Gek
+{
+    // Reads a document from memory and reports it as a sequence of events instead of building a tree
+    // Names and strings are only valid during the callback, they point in to the source unless they contained escapes
+    // Comments and a leading byte order mark are skipped
+    class JSONReader
+    {
+    public:
+        // Returning false from any callback stops the read
+        struct Handler
+        {
+            virtual ~Handler(void) = default;
+
+            virtual bool onObjectBegin(void) = 0;
+            virtual bool onObjectEnd(void) = 0;
+            virtual bool onArrayBegin(void) = 0;
+            virtual bool onArrayEnd(void) = 0;
+            virtual bool onName(std::string_view name) = 0;
+
+            virtual bool onNull(void) = 0;
+            virtual bool onBoolean(bool value) = 0;
+            virtual bool onSigned(int64_t value) = 0;
+            virtual bool onUnsigned(uint64_t value) = 0;
+            virtual bool onFloat(double value) = 0;
+            virtual bool onString(std::string_view value) = 0;
+        };
+
+    private:
+        static const uint32_t MaximumDepth = 512;
+
+        Handler *handler = nullptr;
+        char const *begin = nullptr;
+        char const *current = nullptr;
+        char const *end = nullptr;
+        char const *errorMessage = nullptr;
+        uint32_t depth = 0;
+        std::string stringBuffer;
+
+    public:
+        bool read(std::string_view text, Handler &handler);
+
+        char const *getError(void) const;
+
+        // Positions are only needed for errors, so they are counted on request instead of tracked per character
+        void getPosition(uint32_t &line, uint32_t &column) const;
+
+    private:
+        bool setError(char const *message);
+        bool skipWhiteSpace(void);
+        bool parseHexadecimal(uint32_t &codePoint);
+        bool parseString(std::string_view &result);
+        bool parseLiteral(std::string_view literal);
+        bool parseNumber(void);
+        bool parseArray(void);
+        bool parseObject(void);
+        bool parseValue(void);
+    };
+}; // namespace Gek
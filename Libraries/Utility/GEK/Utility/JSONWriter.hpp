@@ -0,0 +1,74 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include <string_view>
+#include <functional>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Gek
+{
+    // Writes a document as a sequence of calls in to one growing buffer
+    // With a flush callback the buffer is handed off whenever it fills, so documents of any size can be written
+    // Pretty output puts each member and element on its own line, except single line arrays which stay on one
+    class JSONWriter
+    {
+    public:
+        using FlushCallback = std::function<bool(std::string_view data)>;
+
+    private:
+        static const size_t FlushSize = (64 * 1024);
+
+        struct Scope
+        {
+            bool isObject = false;
+            bool singleLine = false;
+            uint32_t count = 0;
+        };
+
+        std::string buffer;
+        std::vector<Scope> scopeStack;
+        FlushCallback onFlush;
+        bool pretty = false;
+        bool afterName = false;
+        bool valid = true;
+
+    public:
+        JSONWriter(bool pretty = false, FlushCallback &&onFlush = nullptr);
+
+        void beginObject(void);
+        void endObject(void);
+
+        // Single line arrays are only kept on one line in pretty output, they should only hold values
+        void beginArray(bool singleLine = false);
+        void endArray(void);
+
+        void writeName(std::string_view name);
+
+        void writeNull(void);
+        void writeBoolean(bool value);
+        void writeSigned(int64_t value);
+        void writeUnsigned(uint64_t value);
+        void writeFloat(float value);
+        void writeString(std::string_view value);
+
+        // Hands any remaining data to the flush callback, false if any flush has failed
+        bool flush(void);
+
+        // Data that hasn't been flushed, all of it when there is no flush callback
+        std::string &getBuffer(void);
+
+    private:
+        void beginValue(void);
+        void endValue(void);
+        void writeNewLine(size_t depth);
+        void writeQuoted(std::string_view string);
+    };
+}; // namespace Gek
@@ -9,9 +9,11 @@
 
 #include "GEK/Utility/String.hpp"
 #include <unordered_map>
+#include <vector>
 #include <functional>
 #include <iostream>
 #include <optional>
+#include <memory>
 #include <random>
 #include <stack>
 
@@ -48,18 +50,50 @@ namespace Gek
             Function,
         };
 
+        // Built-in operations and functions are executed inline, others are called through their std::function
+        enum class OpCode : uint8_t
+        {
+            Constant = 0,
+            Variable,
+            Identity,
+            Negate,
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Power,
+            Sin,
+            Cos,
+            Tan,
+            Asin,
+            Acos,
+            Atan,
+            Min,
+            Max,
+            Abs,
+            Ceil,
+            Floor,
+            Lerp,
+            Random,
+            UnaryOperation,
+            BinaryOperation,
+            Function,
+        };
+
+        static const uint32_t InvalidVariable = 0xFFFFFFFF;
+
         struct Token
         {
             TokenType type = TokenType::Unknown;
             uint32_t parameterCount = 0;
             std::string string;
             float value = 0.0f;
-            float *variable = nullptr;
+            uint32_t variable = InvalidVariable;
 
             Token(TokenType type = TokenType::Unknown);
             Token(TokenType type, std::string const &string, uint32_t parameterCount = 0);
             Token(float value);
-            Token(float *variable);
+            Token(uint32_t variable);
         };
 
         struct Operation
@@ -68,12 +102,18 @@ namespace Gek
             Associations association;
             std::function<float(float value)> unaryFunction;
             std::function<float(float valueLeft, float valueRight)> binaryFunction;
+            OpCode unaryCode = OpCode::UnaryOperation;
+            OpCode binaryCode = OpCode::BinaryOperation;
         };
 
         struct Function
         {
             uint32_t parameterCount;
             std::function<float(std::stack<float> &)> function;
+
+            // False if repeated calls with the same parameters can return different values
+            bool deterministic = true;
+            OpCode code = OpCode::Function;
         };
 
         struct Operand
@@ -82,7 +122,7 @@ namespace Gek
             union
             {
                 float value;
-                float *variable;
+                uint32_t variable;
                 Operation *operation;
                 Function *function;
             };
@@ -97,30 +137,71 @@ namespace Gek
         using TokenList = std::vector<Token>;
         using OperandList = std::vector<Operand>;
 
+        struct Instruction
+        {
+            OpCode code = OpCode::Constant;
+            union
+            {
+                float value = 0.0f;
+                uint32_t variable;
+                Operation *operation;
+                Function *function;
+            };
+        };
+
+        // An expression compiled to a flat list of instructions, deterministic operations on constants are folded
+        // The value stack depth is checked when compiling, so evaluating never checks it
+        struct Program
+        {
+            std::vector<Instruction> instructionList;
+
+            // Slots of the context variables the program reads
+            std::vector<uint32_t> variableList;
+            bool valid = false;
+            bool deterministic = true;
+        };
+
+        static const uint32_t MaximumStackSize = 32;
+
     private:
+        // Operations, functions, variable names, and compiled programs are shared by every context
+        struct Library;
+        static Library &GetLibrary(void);
+
+        // A context only holds its variable values and random sequence, so each thread can use its own
         uint32_t seed = std::mt19937::default_seed;
-        std::unordered_map<std::string, float> variableMap;
-        std::unordered_map<std::string, Operation> operationsMap;
-        std::unordered_map<std::string, Function> functionsMap;
         std::mt19937 mersineTwister;
 
-        std::unordered_map<size_t, OperandList> cache;
+        // Indexed by the slot the variable name is registered to in the library
+        std::vector<float> variableList;
+        std::vector<bool> assignedList;
 
     public:
         ShuntingYard(void);
-        ShuntingYard(ShuntingYard const &shuntingYard);
+        ShuntingYard(ShuntingYard const &shuntingYard) = default;
 
         void setVariable(std::string const &name, float value);
-        void setOperation(std::string const &name, int precedence, Associations association, std::function<float(float value)> &unaryFunction, std::function<float(float valueLeft, float valueRight)> &binaryFunction);
-        void setFunction(std::string const &name, uint32_t parameterCount, std::function<float(std::stack<float> &)> &function);
+
+        // Operations and functions are registered for every context, and should be set before evaluating
+        static void setOperation(std::string const &name, int precedence, Associations association, std::function<float(float value)> &unaryFunction, std::function<float(float valueLeft, float valueRight)> &binaryFunction);
+        static void setFunction(std::string const &name, uint32_t parameterCount, std::function<float(std::stack<float> &)> &function, bool deterministic = true);
 
         void setRandomSeed(uint32_t seed);
         uint32_t getRandomSeed(void);
 
         std::optional<OperandList> getTokenList(std::string const &expression);
+        Program compile(OperandList const &rpnOperandList);
+
+        // The program is owned by the shared cache, null if the expression is not valid
+        std::shared_ptr<Program const> getProgram(std::string const &expression);
+
+        std::optional<float> evaluate(Program const &program);
         std::optional<float> evaluate(OperandList &rpnOperandList);
         std::optional<float> evaluate(std::string const &expression);
 
+        // True if the expression always evaluates to the same value, plain strings that are not expressions count as deterministic
+        bool isDeterministic(std::string const &expression);
+
     private:
         bool isAssociative(std::string const &token, const Associations &type);
         int comparePrecedence(std::string const &token1, std::string const &token2);
@@ -130,6 +211,6 @@ namespace Gek
 		bool insertToken(TokenList &infixTokenList, Token &token);
         std::optional<TokenList> convertExpressionToInfix(std::string const &expression);
         std::optional<OperandList> convertInfixToReversePolishNotation(TokenList const &infixTokenList);
-        std::optional<float> evaluateReversePolishNotation(OperandList const &rpnOperandList);
+        void execute(Instruction const *instruction, Instruction const *lastInstruction, float *&stackTop);
     };
 }; // namespace Gek
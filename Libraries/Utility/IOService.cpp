@@ -0,0 +1,208 @@
+#include "GEK/Utility/IOService.hpp"
+#include "GEK/Utility/Context.hpp"
+#include <algorithm>
+
+namespace Gek
+{
+    IOService::IOService(Context const *context)
+        : context(context)
+    {
+        // A single thread keeps requests to the same device in order, the wait is the disk not the processor
+        ioThread = std::thread([this](void) -> void
+        {
+            std::vector<Item> batch;
+            while (getNextBatch(batch))
+            {
+                readBatch(batch);
+                batch.clear();
+            };
+        });
+    }
+
+    IOService::~IOService(void)
+    {
+        if (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stop = true;
+            itemMap.clear();
+            pendingList.clear();
+        }
+
+        condition.notify_all();
+        ioThread.join();
+    }
+
+    IOService::Request IOService::read(FileSystem::Path const &path, Priority priority, Callback &&onLoaded, Dispatch &&dispatch, bool includeCache)
+    {
+        // Archive lookups are only a hash search, so they're resolved here to let the I/O thread batch by archive
+        Archive::Entry const *entry = nullptr;
+        auto archive = context->findArchiveEntry(path, entry);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stop)
+        {
+            return InvalidRequest;
+        }
+
+        auto request = nextRequest++;
+        itemMap.insert(std::make_pair(request, Item{ request, priority, path, includeCache, archive, entry, std::move(onLoaded), std::move(dispatch) }));
+        pendingList.push_back(request);
+        lock.unlock();
+
+        condition.notify_one();
+        return request;
+    }
+
+    bool IOService::cancel(Request request)
+    {
+        // Pending list entries are skipped once their item is gone, so only the map needs updating
+        std::unique_lock<std::mutex> lock(mutex);
+        return (itemMap.erase(request) > 0);
+    }
+
+    bool IOService::getNextBatch(std::vector<Item> &batch)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            condition.wait(lock, [this](void) -> bool
+            {
+                return (stop || !pendingList.empty());
+            });
+
+            if (stop)
+            {
+                return false;
+            }
+
+            // Highest priority first, then in the order requested
+            Item const *nextItem = nullptr;
+            for (auto pendingSearch = std::begin(pendingList); pendingSearch != std::end(pendingList); )
+            {
+                auto itemSearch = itemMap.find(*pendingSearch);
+                if (itemSearch == std::end(itemMap))
+                {
+                    pendingSearch = pendingList.erase(pendingSearch);
+                    continue;
+                }
+
+                auto &item = itemSearch->second;
+                if (!nextItem || item.priority > nextItem->priority || (item.priority == nextItem->priority && item.request < nextItem->request))
+                {
+                    nextItem = &item;
+                }
+
+                ++pendingSearch;
+            }
+
+            if (!nextItem)
+            {
+                continue;
+            }
+
+            // Entries from the same archive at the same priority are read together so that neighbours can be merged
+            auto archive = nextItem->archive;
+            auto priority = nextItem->priority;
+            auto request = nextItem->request;
+            pendingList.erase(std::remove_if(std::begin(pendingList), std::end(pendingList), [&](Request pendingRequest) -> bool
+            {
+                auto &item = itemMap.at(pendingRequest);
+                if (pendingRequest == request || (archive && item.archive == archive && item.priority == priority))
+                {
+                    batch.push_back(item);
+                    return true;
+                }
+
+                return false;
+            }), std::end(pendingList));
+
+            return true;
+        };
+    }
+
+    void IOService::readBatch(std::vector<Item> &batch)
+    {
+        auto archive = batch.front().archive;
+        if (archive)
+        {
+            std::sort(std::begin(batch), std::end(batch), [](Item const &left, Item const &right) -> bool
+            {
+                return (left.entry->offset < right.entry->offset);
+            });
+
+            for (auto runStart = std::begin(batch); runStart != std::end(batch); )
+            {
+                auto startOffset = runStart->entry->offset;
+                auto endOffset = (startOffset + runStart->entry->size);
+                auto runEnd = std::next(runStart);
+                for (; runEnd != std::end(batch); ++runEnd)
+                {
+                    auto entryEnd = (runEnd->entry->offset + runEnd->entry->size);
+                    if (runEnd->entry->offset > (endOffset + CoalesceGapSize) || (std::max(endOffset, entryEnd) - startOffset) > MaximumCoalesceSize)
+                    {
+                        break;
+                    }
+
+                    endOffset = std::max(endOffset, entryEnd);
+                }
+
+                archive->prefetch(startOffset, (endOffset - startOffset));
+                for (; runStart != runEnd; ++runStart)
+                {
+                    auto entry = runStart->entry;
+                    auto onLoaded = runStart->onLoaded;
+                    complete(*runStart, [archive, entry, onLoaded = std::move(onLoaded)](void) -> void
+                    {
+                        Archive::Data data;
+                        archive->read(*entry, data);
+                        onLoaded(std::move(data));
+                    });
+                }
+            };
+        }
+        else
+        {
+            for (auto &item : batch)
+            {
+                auto file = std::make_shared<FileSystem::MappedFile>(context->findDataPath(item.path, item.includeCache));
+                file->prefetch(0, file->size());
+                auto onLoaded = item.onLoaded;
+                complete(item, [file, onLoaded = std::move(onLoaded)](void) -> void
+                {
+                    Archive::Data data;
+                    if (!file->empty())
+                    {
+                        data.setFile(std::move(*file));
+                    }
+
+                    onLoaded(std::move(data));
+                });
+            }
+        }
+    }
+
+    bool IOService::complete(Item &item, std::function<void(void)> &&task)
+    {
+        // Removing the item is what commits to calling back, so cancel can't race with the dispatch
+        if (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (itemMap.erase(item.request) == 0)
+            {
+                return false;
+            }
+        }
+
+        if (item.dispatch)
+        {
+            item.dispatch(std::move(task));
+        }
+        else
+        {
+            task();
+        }
+
+        return true;
+    }
+}; // namespace Gek
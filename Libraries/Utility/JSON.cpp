@@ -1,7 +1,9 @@
 #include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/JSONReader.hpp"
+#include "GEK/Utility/JSONWriter.hpp"
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/Context.hpp"
-#include <jsoncons/json.hpp>
+#include <algorithm>
 
 namespace Gek
 {
@@ -9,164 +11,430 @@ namespace Gek
     const JSON::Object JSON::EmptyObject = JSON::Object();
     const JSON JSON::Empty = JSON();
 
-    JSON GetFromJSON(jsoncons::json const &object)
+    JSON::Object::iterator JSON::Object::find(std::string_view name)
     {
-        if (object.is_empty() || object.is_null())
+        auto search = std::lower_bound(std::begin(memberList), std::end(memberList), name, [](value_type const &member, std::string_view name) -> bool
         {
-            return JSON::Empty;
+            return (member.first < name);
+        });
+
+        return ((search != std::end(memberList) && search->first == name) ? search : std::end(memberList));
+    }
+
+    JSON::Object::const_iterator JSON::Object::find(std::string_view name) const
+    {
+        auto search = std::lower_bound(std::begin(memberList), std::end(memberList), name, [](value_type const &member, std::string_view name) -> bool
+        {
+            return (member.first < name);
+        });
+
+        return ((search != std::end(memberList) && search->first == name) ? search : std::end(memberList));
+    }
+
+    size_t JSON::Object::count(std::string_view name) const
+    {
+        return (find(name) == std::end(memberList) ? 0 : 1);
+    }
+
+    JSON &JSON::Object::operator [] (std::string_view name)
+    {
+        auto search = std::lower_bound(std::begin(memberList), std::end(memberList), name, [](value_type const &member, std::string_view name) -> bool
+        {
+            return (member.first < name);
+        });
+
+        if (search == std::end(memberList) || search->first != name)
+        {
+            search = memberList.insert(search, value_type(std::string(name), JSON()));
         }
 
-        JSON value;
-        switch (object.type_id())
+        return search->second;
+    }
+
+    std::pair<JSON::Object::iterator, bool> JSON::Object::insert(value_type &&member)
+    {
+        auto search = std::lower_bound(std::begin(memberList), std::end(memberList), member.first, [](value_type const &member, std::string const &name) -> bool
         {
-        case jsoncons::json_type_tag::small_string_t:
-        case jsoncons::json_type_tag::string_t:
-            value = object.as_string();
-            break;
+            return (member.first < name);
+        });
 
-        case jsoncons::json_type_tag::bool_t:
-            value = object.as_bool();
-            break;
+        if (search != std::end(memberList) && search->first == member.first)
+        {
+            return std::make_pair(search, false);
+        }
 
-        case jsoncons::json_type_tag::double_t:
-            value = float(object.as_double());
-            break;
+        return std::make_pair(memberList.insert(search, std::move(member)), true);
+    }
+
+    JSON::Object::iterator JSON::Object::erase(const_iterator position)
+    {
+        return memberList.erase(position);
+    }
+
+    size_t JSON::Object::erase(std::string_view name)
+    {
+        auto search = find(name);
+        if (search == std::end(memberList))
+        {
+            return 0;
+        }
+
+        memberList.erase(search);
+        return 1;
+    }
 
-        case jsoncons::json_type_tag::integer_t:
-            value = object.as_integer();
-            break;
+    void JSON::Object::append(std::string_view name, JSON &&value)
+    {
+        memberList.emplace_back(std::string(name), std::move(value));
+    }
 
-        case jsoncons::json_type_tag::uinteger_t:
-            value = object.as_uinteger();
-            break;
+    void JSON::Object::sort(void)
+    {
+        std::stable_sort(std::begin(memberList), std::end(memberList), [](value_type const &left, value_type const &right) -> bool
+        {
+            return (left.first < right.first);
+        });
 
-        case jsoncons::json_type_tag::array_t:
-            value = JSON::Array(object.size());
-            for (size_t index = 0; index < object.size(); ++index)
+        // Keep the last of any duplicated names, matching assignment order
+        auto last = std::end(memberList);
+        auto write = std::begin(memberList);
+        for (auto read = std::begin(memberList); read != last; ++read)
+        {
+            auto next = std::next(read);
+            if (next != last && next->first == read->first)
             {
-                value[index] = GetFromJSON(object[index]);
+                continue;
             }
 
-            break;
-
-        case jsoncons::json_type_tag::object_t:
-            value = JSON::Object();
-            for (auto &pair : object.members())
+            if (write != read)
             {
-                value[pair.name()] = GetFromJSON(pair.value());
+                *write = std::move(*read);
             }
 
-            break;
-        };
+            ++write;
+        }
 
-        return value;
+        memberList.erase(write, last);
     }
 
-    void JSON::load(FileSystem::Path const &filePath)
+    namespace
     {
-        if (filePath.isFile())
+        // Builds nodes from reader events, matching the previous reader so existing data loads the same:
+        // empty strings, arrays and objects load as null, and numbers with fractions or exponents load as float
+        class DocumentBuilder
+            : public JSONReader::Handler
         {
-            std::string object(FileSystem::Load(filePath, String::Empty));
-            std::istringstream dataStream(object);
-            jsoncons::json_decoder<jsoncons::json> decoder;
-            jsoncons::json_reader reader(dataStream, decoder);
+        private:
+            struct Container
+            {
+                JSON *node = nullptr;
+                bool isObject = false;
+            };
 
-            std::error_code errorCode;
-            reader.read(errorCode);
-            if (errorCode)
+            JSON &root;
+            std::vector<Container> containerStack;
+            std::string name;
+
+            std::string_view streamName;
+            JSON::StreamCallback const *onStreamElement = nullptr;
+            JSON *streamArray = nullptr;
+
+        public:
+            DocumentBuilder(JSON &root, std::string_view streamName = std::string_view(), JSON::StreamCallback const *onStreamElement = nullptr)
+                : root(root)
+                , streamName(streamName)
+                , onStreamElement(onStreamElement)
             {
-                LockedWrite{ std::cerr } << errorCode.message() << " at line " << reader.line_number() << ", and column " << reader.column_number() << ", in " << filePath.getString();
             }
-            else
+
+        private:
+            JSON &beginValue(void)
+            {
+                if (containerStack.empty())
+                {
+                    return root;
+                }
+
+                auto &parent = containerStack.back();
+                if (!parent.isObject)
+                {
+                    return parent.node->makeType<JSON::Array>().emplace_back();
+                }
+
+                // Members of the root are kept in order as they are read so a streamed element can look them up,
+                // everything else is sorted once when its object ends
+                auto &object = parent.node->makeType<JSON::Object>();
+                if (containerStack.size() == 1 && onStreamElement)
+                {
+                    auto &member = object[name];
+                    member = JSON();
+                    return member;
+                }
+
+                object.append(name, JSON());
+                return (std::end(object) - 1)->second;
+            }
+
+            bool endValue(void)
+            {
+                if (streamArray && containerStack.back().node == streamArray)
+                {
+                    auto &array = streamArray->makeType<JSON::Array>();
+                    JSON element(std::move(array.back()));
+                    array.pop_back();
+                    return (*onStreamElement)(root, std::move(element));
+                }
+
+                return true;
+            }
+
+            template <typename TYPE>
+            bool setValue(TYPE &&value)
+            {
+                beginValue() = std::move(value);
+                return endValue();
+            }
+
+        public:
+            // JSONReader::Handler
+            bool onObjectBegin(void)
             {
-                *this = GetFromJSON(decoder.get_result());
+                auto &node = beginValue();
+                node.makeType<JSON::Object>();
+                containerStack.push_back({ &node, true });
+                return true;
+            }
+
+            bool onObjectEnd(void)
+            {
+                auto node = containerStack.back().node;
+                containerStack.pop_back();
+
+                auto &object = node->makeType<JSON::Object>();
+                if (object.empty())
+                {
+                    *node = JSON::Empty;
+                }
+                else
+                {
+                    object.sort();
+                }
+
+                return (containerStack.empty() || endValue());
+            }
+
+            bool onArrayBegin(void)
+            {
+                auto &node = beginValue();
+                node.makeType<JSON::Array>();
+                if (onStreamElement && containerStack.size() == 1 && containerStack.back().isObject && name == streamName)
+                {
+                    streamArray = &node;
+                }
+
+                containerStack.push_back({ &node, false });
+                return true;
+            }
+
+            bool onArrayEnd(void)
+            {
+                auto node = containerStack.back().node;
+                containerStack.pop_back();
+                if (node == streamArray)
+                {
+                    streamArray = nullptr;
+                }
+
+                if (node->makeType<JSON::Array>().empty())
+                {
+                    *node = JSON::Empty;
+                }
+
+                return (containerStack.empty() || endValue());
             }
+
+            bool onName(std::string_view name)
+            {
+                this->name.assign(name.data(), name.size());
+                return true;
+            }
+
+            bool onNull(void)
+            {
+                return setValue(JSON());
+            }
+
+            bool onBoolean(bool value)
+            {
+                return setValue(JSON(value));
+            }
+
+            bool onSigned(int64_t value)
+            {
+                return setValue(JSON(value));
+            }
+
+            bool onUnsigned(uint64_t value)
+            {
+                return setValue(JSON(value));
+            }
+
+            bool onFloat(double value)
+            {
+                return setValue(JSON(float(value)));
+            }
+
+            bool onString(std::string_view value)
+            {
+                return setValue(value.empty() ? JSON() : JSON(std::string(value)));
+            }
+        };
+
+        bool ParseDocument(JSON &value, std::string_view text, std::string_view sourceName, std::string_view streamName, JSON::StreamCallback const *onStreamElement)
+        {
+            JSONReader reader;
+            DocumentBuilder builder(value, streamName, onStreamElement);
+            if (!reader.read(text, builder))
+            {
+                uint32_t line = 0, column = 0;
+                reader.getPosition(line, column);
+                LockedWrite{ std::cerr } << reader.getError() << " at line " << line << ", and column " << column << ", in " << sourceName;
+                return false;
+            }
+
+            return true;
         }
-    }
+    }; // namespace
 
-    void JSON::save(FileSystem::Path const &filePath)
+    bool JSON::parse(std::string_view text, std::string_view sourceName)
     {
-        FileSystem::Save(filePath, getString());
+        JSON value;
+        if (!ParseDocument(value, text, sourceName, std::string_view(), nullptr))
+        {
+            return false;
+        }
+
+        *this = std::move(value);
+        return true;
     }
 
-    std::string escapeJsonString(const std::string& input)
+    bool JSON::parse(std::string_view text, std::string_view sourceName, std::string_view streamName, StreamCallback const &onStreamElement)
     {
-        std::ostringstream ss;
-        for (auto iter = input.cbegin(); iter != input.cend(); iter++)
+        JSON value;
+        if (!ParseDocument(value, text, sourceName, streamName, &onStreamElement))
         {
-            //C++98/03:
-            //for (std::string::const_iterator iter = input.begin(); iter != input.end(); iter++) {
-            switch (*iter)
-            {
-            case '\\': ss << "\\\\"; break;
-            case '"': ss << "\\\""; break;
-            case '/': ss << "\\/"; break;
-            case '\b': ss << "\\b"; break;
-            case '\f': ss << "\\f"; break;
-            case '\n': ss << "\\n"; break;
-            case '\r': ss << "\\r"; break;
-            case '\t': ss << "\\t"; break;
-            default: ss << *iter; break;
-            };
+            return false;
         }
 
-        return ss.str();
+        *this = std::move(value);
+        return true;
     }
 
-    std::string JSON::getString(void) const
+    void JSON::load(FileSystem::Path const &filePath)
     {
-        return visit(
-            [](std::string const &visitedData)
+        if (filePath.isFile())
         {
-            return String::Format("\"{}\"", escapeJsonString(visitedData));
-        },
-            [](JSON::Array const &visitedData)
+            std::string object(FileSystem::Load(filePath, String::Empty));
+            parse(object, filePath.getString());
+        }
+    }
+
+    void JSON::save(FileSystem::Path const &filePath, bool pretty) const
+    {
+        filePath.getParentPath().createChain();
+
+        FILE *file = nullptr;
+        _wfopen_s(&file, filePath.getWindowsString().data(), L"wb");
+        if (file == nullptr)
         {
-            std::stringstream stream;
+            LockedWrite{ std::cerr } << "Unable to open file for writing: " << filePath.getString();
+            return;
+        }
 
-            stream << "[ ";
-            bool writtenPrevious = false;
-            for (auto &index : visitedData)
-            {
-                if (writtenPrevious)
-                {
-                    stream << ", ";
-                }
+        JSONWriter writer(pretty, [file](std::string_view data) -> bool
+        {
+            return (fwrite(data.data(), data.size(), 1, file) == 1);
+        });
 
-                stream << index.getString();
-                writtenPrevious = true;
-            }
+        write(writer);
+        if (!writer.flush())
+        {
+            LockedWrite{ std::cerr } << "Unable to write file: " << filePath.getString();
+        }
 
-            stream << "]";
-            return stream.str();
+        fclose(file);
+    }
+
+    void JSON::write(JSONWriter &writer) const
+    {
+        visit(
+            [&writer](std::nullptr_t const &visitedData)
+        {
+            writer.writeNull();
         },
-            [](JSON::Object const &visitedData)
+            [&writer](bool const &visitedData)
         {
-            std::stringstream stream;
-
-            stream << "{ ";
-            bool writtenPrevious = false;
-            for (auto &index : visitedData)
+            writer.writeBoolean(visitedData);
+        },
+            [&writer](int32_t const &visitedData)
+        {
+            writer.writeSigned(visitedData);
+        },
+            [&writer](int64_t const &visitedData)
+        {
+            writer.writeSigned(visitedData);
+        },
+            [&writer](uint32_t const &visitedData)
+        {
+            writer.writeUnsigned(visitedData);
+        },
+            [&writer](uint64_t const &visitedData)
+        {
+            writer.writeUnsigned(visitedData);
+        },
+            [&writer](float const &visitedData)
+        {
+            writer.writeFloat(visitedData);
+        },
+            [&writer](std::string const &visitedData)
+        {
+            writer.writeString(visitedData);
+        },
+            [&writer](Array const &visitedData)
+        {
+            // Vectors and other lists of plain values stay on one line
+            writer.beginArray(std::none_of(std::begin(visitedData), std::end(visitedData), [](JSON const &element) -> bool
             {
-                if (writtenPrevious)
-                {
-                    stream << ", ";
-                }
+                return (element.isType<Array>() || element.isType<Object>());
+            }));
 
-                stream << "\"" << index.first << "\": ";
-                stream << index.second.getString();
-                writtenPrevious = true;
+            for (auto const &element : visitedData)
+            {
+                element.write(writer);
             }
 
-            stream << "}";
-            return stream.str();
+            writer.endArray();
         },
-            [](auto && visitedData)
+            [&writer](Object const &visitedData)
         {
-            return String::Format("{}", visitedData);
+            writer.beginObject();
+            for (auto const &member : visitedData)
+            {
+                writer.writeName(member.first);
+                member.second.write(writer);
+            }
+
+            writer.endObject();
         });
     }
 
+    std::string JSON::getString(bool pretty) const
+    {
+        JSONWriter writer(pretty);
+        write(writer);
+        return std::move(writer.getBuffer());
+    }
+
     JSON const &JSON::getIndex(size_t index) const
     {
         if (auto value = std::get_if<Array>(&data))
@@ -183,7 +451,7 @@ namespace Gek
     {
         if (auto value = std::get_if<Object>(&data))
         {
-            auto search = value->find(name.data());
+            auto search = value->find(name);
             if (search == std::end(*value))
             {
                 return Empty;
@@ -216,12 +484,12 @@ namespace Gek
             data = EmptyObject;
         }
 
-        return std::get<Object>(data)[name.data()];
+        return std::get<Object>(data)[name];
     }
 
     Math::Float2 JSON::evaluate(ShuntingYard &shuntingYard, Math::Float2 const &defaultValue) const
     {
-        auto data = asType(EmptyArray);
+        auto const &data = asType(EmptyArray);
         switch (data.size())
         {
         case 1:
@@ -236,7 +504,7 @@ namespace Gek
 
     Math::Float3 JSON::evaluate(ShuntingYard &shuntingYard, Math::Float3 const &defaultValue) const
     {
-        auto data = asType(EmptyArray);
+        auto const &data = asType(EmptyArray);
         switch (data.size())
         {
         case 1:
@@ -255,7 +523,7 @@ namespace Gek
 
     Math::Float4 JSON::evaluate(ShuntingYard &shuntingYard, Math::Float4 const &defaultValue) const
     {
-        auto data = asType(EmptyArray);
+        auto const &data = asType(EmptyArray);
         switch (data.size())
         {
         case 1:
@@ -282,7 +550,7 @@ namespace Gek
 
     Math::Quaternion JSON::evaluate(ShuntingYard &shuntingYard, Math::Quaternion const &defaultValue) const
     {
-        auto data = asType(EmptyArray);
+        auto const &data = asType(EmptyArray);
         switch (data.size())
         {
         case 3:
@@ -331,4 +599,31 @@ namespace Gek
             return String::Format("{}", GetValueOrDefault(visitedData, defaultValue));
         });
     }
+
+    bool JSON::isDeterministic(ShuntingYard &shuntingYard) const
+    {
+        return visit(
+            [&shuntingYard](std::string const &visitedData) -> bool
+        {
+            return shuntingYard.isDeterministic(visitedData);
+        },
+            [&shuntingYard](Object const &visitedData) -> bool
+        {
+            return std::all_of(std::begin(visitedData), std::end(visitedData), [&shuntingYard](auto const &member) -> bool
+            {
+                return member.second.isDeterministic(shuntingYard);
+            });
+        },
+            [&shuntingYard](Array const &visitedData) -> bool
+        {
+            return std::all_of(std::begin(visitedData), std::end(visitedData), [&shuntingYard](auto const &element) -> bool
+            {
+                return element.isDeterministic(shuntingYard);
+            });
+        },
+            [](auto const &visitedData) -> bool
+        {
+            return true;
+        });
+    }
 }; // namespace Gek
@@ -0,0 +1,592 @@
+#include "GEK/Utility/JSONReader.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std::string_view_literals;
+
+namespace Gek
+{
+    namespace
+    {
+        bool IsDigit(char character)
+        {
+            return (character >= '0' && character <= '9');
+        }
+
+        void AppendCodePoint(std::string &buffer, uint32_t codePoint)
+        {
+            if (codePoint < 0x80)
+            {
+                buffer.push_back(char(codePoint));
+            }
+            else if (codePoint < 0x800)
+            {
+                buffer.push_back(char(0xC0 | (codePoint >> 6)));
+                buffer.push_back(char(0x80 | (codePoint & 0x3F)));
+            }
+            else if (codePoint < 0x10000)
+            {
+                buffer.push_back(char(0xE0 | (codePoint >> 12)));
+                buffer.push_back(char(0x80 | ((codePoint >> 6) & 0x3F)));
+                buffer.push_back(char(0x80 | (codePoint & 0x3F)));
+            }
+            else
+            {
+                buffer.push_back(char(0xF0 | (codePoint >> 18)));
+                buffer.push_back(char(0x80 | ((codePoint >> 12) & 0x3F)));
+                buffer.push_back(char(0x80 | ((codePoint >> 6) & 0x3F)));
+                buffer.push_back(char(0x80 | (codePoint & 0x3F)));
+            }
+        }
+    }; // namespace
+
+    bool JSONReader::read(std::string_view text, Handler &handler)
+    {
+        this->handler = &handler;
+        begin = current = text.data();
+        end = (text.data() + text.size());
+        errorMessage = nullptr;
+        depth = 0;
+        if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF"sv) == 0)
+        {
+            current += 3;
+        }
+
+        if (!parseValue() || !skipWhiteSpace())
+        {
+            return false;
+        }
+
+        if (current != end)
+        {
+            return setError("Unexpected data after the root value");
+        }
+
+        return true;
+    }
+
+    char const *JSONReader::getError(void) const
+    {
+        return (errorMessage ? errorMessage : "");
+    }
+
+    void JSONReader::getPosition(uint32_t &line, uint32_t &column) const
+    {
+        line = 1;
+        auto lineStart = begin;
+        for (auto search = begin; search < current; ++search)
+        {
+            if (*search == '\n')
+            {
+                lineStart = (search + 1);
+                ++line;
+            }
+        }
+
+        column = uint32_t(current - lineStart) + 1;
+    }
+
+    bool JSONReader::setError(char const *message)
+    {
+        // Keep the first error, callers unwinding after a failure don't replace it
+        if (!errorMessage)
+        {
+            errorMessage = message;
+        }
+
+        return false;
+    }
+
+    bool JSONReader::skipWhiteSpace(void)
+    {
+        while (current < end)
+        {
+            switch (*current)
+            {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                ++current;
+                break;
+
+            case '/':
+                if ((end - current) > 1 && current[1] == '/')
+                {
+                    current = std::find(current + 2, end, '\n');
+                    break;
+                }
+                else if ((end - current) > 1 && current[1] == '*')
+                {
+                    auto commentEnd = std::string_view(current, end - current).find("*/"sv, 2);
+                    if (commentEnd == std::string_view::npos)
+                    {
+                        return setError("Unterminated comment");
+                    }
+
+                    current += (commentEnd + 2);
+                    break;
+                }
+
+                return setError("Unexpected character");
+
+            default:
+                return true;
+            };
+        }
+
+        return true;
+    }
+
+    bool JSONReader::parseHexadecimal(uint32_t &codePoint)
+    {
+        if ((end - current) < 4)
+        {
+            return setError("Unexpected end of data in escape sequence");
+        }
+
+        codePoint = 0;
+        for (auto last = (current + 4); current < last; ++current)
+        {
+            codePoint <<= 4;
+            auto character = *current;
+            if (IsDigit(character))
+            {
+                codePoint |= (character - '0');
+            }
+            else if (character >= 'a' && character <= 'f')
+            {
+                codePoint |= (character - 'a' + 10);
+            }
+            else if (character >= 'A' && character <= 'F')
+            {
+                codePoint |= (character - 'A' + 10);
+            }
+            else
+            {
+                return setError("Invalid hexadecimal digit in escape sequence");
+            }
+        }
+
+        return true;
+    }
+
+    // Returns a view of the source when there are no escapes, otherwise decodes in to the string buffer
+    bool JSONReader::parseString(std::string_view &result)
+    {
+        auto stringStart = ++current;
+        while (current < end && *current != '"' && *current != '\\')
+        {
+            if (static_cast<unsigned char>(*current) < 0x20)
+            {
+                return setError("Illegal control character in string");
+            }
+
+            ++current;
+        }
+
+        if (current == end)
+        {
+            return setError("Unterminated string");
+        }
+
+        if (*current == '"')
+        {
+            result = std::string_view(stringStart, current - stringStart);
+            ++current;
+            return true;
+        }
+
+        stringBuffer.assign(stringStart, current);
+        while (current < end && *current != '"')
+        {
+            auto character = *current++;
+            if (static_cast<unsigned char>(character) < 0x20)
+            {
+                --current;
+                return setError("Illegal control character in string");
+            }
+            else if (character != '\\')
+            {
+                stringBuffer.push_back(character);
+                continue;
+            }
+
+            if (current == end)
+            {
+                break;
+            }
+
+            switch (*current++)
+            {
+            case '"':
+                stringBuffer.push_back('"');
+                break;
+
+            case '\\':
+                stringBuffer.push_back('\\');
+                break;
+
+            case '/':
+                stringBuffer.push_back('/');
+                break;
+
+            case 'b':
+                stringBuffer.push_back('\b');
+                break;
+
+            case 'f':
+                stringBuffer.push_back('\f');
+                break;
+
+            case 'n':
+                stringBuffer.push_back('\n');
+                break;
+
+            case 'r':
+                stringBuffer.push_back('\r');
+                break;
+
+            case 't':
+                stringBuffer.push_back('\t');
+                break;
+
+            case 'u':
+                if (true)
+                {
+                    uint32_t codePoint = 0;
+                    if (!parseHexadecimal(codePoint))
+                    {
+                        return false;
+                    }
+
+                    if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+                    {
+                        uint32_t lowSurrogate = 0;
+                        if ((end - current) < 2 || current[0] != '\\' || current[1] != 'u')
+                        {
+                            return setError("Expected low surrogate in escape sequence");
+                        }
+
+                        current += 2;
+                        if (!parseHexadecimal(lowSurrogate))
+                        {
+                            return false;
+                        }
+
+                        if (lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+                        {
+                            return setError("Invalid low surrogate in escape sequence");
+                        }
+
+                        codePoint = (0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00));
+                    }
+
+                    AppendCodePoint(stringBuffer, codePoint);
+                    break;
+                }
+
+            default:
+                --current;
+                return setError("Illegal escape sequence");
+            };
+        }
+
+        if (current == end)
+        {
+            return setError("Unterminated string");
+        }
+
+        ++current;
+        result = stringBuffer;
+        return true;
+    }
+
+    bool JSONReader::parseLiteral(std::string_view literal)
+    {
+        if (std::string_view(current, std::min(size_t(end - current), literal.size())) != literal)
+        {
+            return setError("Expected value");
+        }
+
+        current += literal.size();
+        return true;
+    }
+
+    bool JSONReader::parseNumber(void)
+    {
+        auto numberStart = current;
+        bool negative = (*current == '-');
+        if (negative)
+        {
+            ++current;
+        }
+
+        if (current == end || !IsDigit(*current))
+        {
+            current = numberStart;
+            return setError("Expected value");
+        }
+
+        if (*current == '0')
+        {
+            ++current;
+        }
+        else
+        {
+            while (current < end && IsDigit(*current))
+            {
+                ++current;
+            }
+        }
+
+        bool isInteger = true;
+        if (current < end && *current == '.')
+        {
+            isInteger = false;
+            if (++current == end || !IsDigit(*current))
+            {
+                return setError("Expected digit after decimal point");
+            }
+
+            while (current < end && IsDigit(*current))
+            {
+                ++current;
+            }
+        }
+
+        if (current < end && (*current == 'e' || *current == 'E'))
+        {
+            isInteger = false;
+            if (++current < end && (*current == '+' || *current == '-'))
+            {
+                ++current;
+            }
+
+            if (current == end || !IsDigit(*current))
+            {
+                return setError("Expected digit in exponent");
+            }
+
+            while (current < end && IsDigit(*current))
+            {
+                ++current;
+            }
+        }
+
+        if (isInteger)
+        {
+            if (negative)
+            {
+                int64_t integer = 0;
+                if (std::from_chars(numberStart, current, integer).ec == std::errc())
+                {
+                    return handler->onSigned(integer) || setError("Read stopped by handler");
+                }
+            }
+            else
+            {
+                uint64_t integer = 0;
+                if (std::from_chars(numberStart, current, integer).ec == std::errc())
+                {
+                    return handler->onUnsigned(integer) || setError("Read stopped by handler");
+                }
+            }
+        }
+
+        // Fractions, exponents, and integers that don't fit in 64 bits
+        // strtod needs a terminated string, the source buffer is not guaranteed to be one
+        double number = 0.0;
+        char numberBuffer[64];
+        auto numberSize = size_t(current - numberStart);
+        if (numberSize < sizeof(numberBuffer))
+        {
+            std::memcpy(numberBuffer, numberStart, numberSize);
+            numberBuffer[numberSize] = 0;
+            number = std::strtod(numberBuffer, nullptr);
+        }
+        else
+        {
+            number = std::strtod(std::string(numberStart, current).data(), nullptr);
+        }
+
+        return handler->onFloat(number) || setError("Read stopped by handler");
+    }
+
+    bool JSONReader::parseArray(void)
+    {
+        ++current;
+        if (!handler->onArrayBegin())
+        {
+            return setError("Read stopped by handler");
+        }
+
+        if (!skipWhiteSpace())
+        {
+            return false;
+        }
+
+        if (current < end && *current == ']')
+        {
+            ++current;
+            return handler->onArrayEnd() || setError("Read stopped by handler");
+        }
+
+        while (true)
+        {
+            if (!parseValue() || !skipWhiteSpace())
+            {
+                return false;
+            }
+
+            if (current == end)
+            {
+                return setError("Unexpected end of data in array");
+            }
+            else if (*current == ',')
+            {
+                ++current;
+            }
+            else if (*current == ']')
+            {
+                ++current;
+                break;
+            }
+            else
+            {
+                return setError("Expected comma or right bracket");
+            }
+        };
+
+        return handler->onArrayEnd() || setError("Read stopped by handler");
+    }
+
+    bool JSONReader::parseObject(void)
+    {
+        ++current;
+        if (!handler->onObjectBegin())
+        {
+            return setError("Read stopped by handler");
+        }
+
+        if (!skipWhiteSpace())
+        {
+            return false;
+        }
+
+        if (current < end && *current == '}')
+        {
+            ++current;
+            return handler->onObjectEnd() || setError("Read stopped by handler");
+        }
+
+        while (true)
+        {
+            if (!skipWhiteSpace())
+            {
+                return false;
+            }
+
+            if (current == end || *current != '"')
+            {
+                return setError("Expected name");
+            }
+
+            std::string_view name;
+            if (!parseString(name))
+            {
+                return false;
+            }
+
+            if (!handler->onName(name))
+            {
+                return setError("Read stopped by handler");
+            }
+
+            if (!skipWhiteSpace())
+            {
+                return false;
+            }
+
+            if (current == end || *current != ':')
+            {
+                return setError("Expected colon after name");
+            }
+
+            ++current;
+            if (!parseValue() || !skipWhiteSpace())
+            {
+                return false;
+            }
+
+            if (current == end)
+            {
+                return setError("Unexpected end of data in object");
+            }
+            else if (*current == ',')
+            {
+                ++current;
+            }
+            else if (*current == '}')
+            {
+                ++current;
+                break;
+            }
+            else
+            {
+                return setError("Expected comma or right brace");
+            }
+        };
+
+        return handler->onObjectEnd() || setError("Read stopped by handler");
+    }
+
+    bool JSONReader::parseValue(void)
+    {
+        if (!skipWhiteSpace())
+        {
+            return false;
+        }
+
+        if (current == end)
+        {
+            return setError("Unexpected end of data");
+        }
+
+        bool parsed = false;
+        switch (*current)
+        {
+        case '{':
+        case '[':
+            if (++depth > MaximumDepth)
+            {
+                return setError("Maximum nesting depth exceeded");
+            }
+
+            parsed = (*current == '{' ? parseObject() : parseArray());
+            --depth;
+            return parsed;
+
+        case '"':
+            if (true)
+            {
+                std::string_view string;
+                return parseString(string) && (handler->onString(string) || setError("Read stopped by handler"));
+            }
+
+        case 't':
+            return parseLiteral("true"sv) && (handler->onBoolean(true) || setError("Read stopped by handler"));
+
+        case 'f':
+            return parseLiteral("false"sv) && (handler->onBoolean(false) || setError("Read stopped by handler"));
+
+        case 'n':
+            return parseLiteral("null"sv) && (handler->onNull() || setError("Read stopped by handler"));
+
+        default:
+            return parseNumber();
+        };
+    }
+}; // namespace Gek
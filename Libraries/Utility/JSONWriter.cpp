@@ -0,0 +1,268 @@
+#include "GEK/Utility/JSONWriter.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace Gek
+{
+    namespace
+    {
+        // Zero for characters that are written as is, otherwise the character following the backslash,
+        // u for control characters without a short escape
+        struct EscapeTable
+        {
+            char escapeList[256] = { 0 };
+
+            EscapeTable(void)
+            {
+                for (size_t character = 0; character < 0x20; ++character)
+                {
+                    escapeList[character] = 'u';
+                }
+
+                escapeList['"'] = '"';
+                escapeList['\\'] = '\\';
+                escapeList['\b'] = 'b';
+                escapeList['\f'] = 'f';
+                escapeList['\n'] = 'n';
+                escapeList['\r'] = 'r';
+                escapeList['\t'] = 't';
+            }
+        };
+
+        const EscapeTable Escapes;
+    }; // namespace
+
+    JSONWriter::JSONWriter(bool pretty, FlushCallback &&onFlush)
+        : onFlush(std::move(onFlush))
+        , pretty(pretty)
+    {
+        buffer.reserve(this->onFlush ? (FlushSize * 2) : 1024);
+    }
+
+    void JSONWriter::beginObject(void)
+    {
+        beginValue();
+        buffer.push_back('{');
+        scopeStack.push_back({ true, false, 0 });
+    }
+
+    void JSONWriter::endObject(void)
+    {
+        auto scope = scopeStack.back();
+        scopeStack.pop_back();
+        if (pretty && scope.count > 0)
+        {
+            writeNewLine(scopeStack.size());
+        }
+
+        buffer.push_back('}');
+        endValue();
+    }
+
+    void JSONWriter::beginArray(bool singleLine)
+    {
+        beginValue();
+        buffer.push_back('[');
+        scopeStack.push_back({ false, singleLine, 0 });
+    }
+
+    void JSONWriter::endArray(void)
+    {
+        auto scope = scopeStack.back();
+        scopeStack.pop_back();
+        if (pretty && scope.count > 0)
+        {
+            if (scope.singleLine)
+            {
+                buffer.push_back(' ');
+            }
+            else
+            {
+                writeNewLine(scopeStack.size());
+            }
+        }
+
+        buffer.push_back(']');
+        endValue();
+    }
+
+    void JSONWriter::writeName(std::string_view name)
+    {
+        beginValue();
+        writeQuoted(name);
+        buffer.push_back(':');
+        if (pretty)
+        {
+            buffer.push_back(' ');
+        }
+
+        afterName = true;
+    }
+
+    void JSONWriter::writeNull(void)
+    {
+        beginValue();
+        buffer.append("null", 4);
+        endValue();
+    }
+
+    void JSONWriter::writeBoolean(bool value)
+    {
+        beginValue();
+        if (value)
+        {
+            buffer.append("true", 4);
+        }
+        else
+        {
+            buffer.append("false", 5);
+        }
+
+        endValue();
+    }
+
+    void JSONWriter::writeSigned(int64_t value)
+    {
+        beginValue();
+        char number[24];
+        auto result = std::to_chars(number, number + sizeof(number), value);
+        buffer.append(number, result.ptr);
+        endValue();
+    }
+
+    void JSONWriter::writeUnsigned(uint64_t value)
+    {
+        beginValue();
+        char number[24];
+        auto result = std::to_chars(number, number + sizeof(number), value);
+        buffer.append(number, result.ptr);
+        endValue();
+    }
+
+    void JSONWriter::writeFloat(float value)
+    {
+        // JSON has no representation for infinity or NaN
+        if (!std::isfinite(value))
+        {
+            writeNull();
+            return;
+        }
+
+        beginValue();
+        char number[32];
+        auto result = std::to_chars(number, number + sizeof(number), value);
+        buffer.append(number, result.ptr);
+
+        // Whole numbers keep a fraction so they read back as floats
+        if (std::find_if(number, result.ptr, [](char character) -> bool
+        {
+            return (character == '.' || character == 'e');
+        }) == result.ptr)
+        {
+            buffer.append(".0", 2);
+        }
+
+        endValue();
+    }
+
+    void JSONWriter::writeString(std::string_view value)
+    {
+        beginValue();
+        writeQuoted(value);
+        endValue();
+    }
+
+    bool JSONWriter::flush(void)
+    {
+        if (onFlush && !buffer.empty())
+        {
+            valid = (onFlush(buffer) && valid);
+            buffer.clear();
+        }
+
+        return valid;
+    }
+
+    std::string &JSONWriter::getBuffer(void)
+    {
+        return buffer;
+    }
+
+    void JSONWriter::beginValue(void)
+    {
+        if (afterName)
+        {
+            afterName = false;
+            return;
+        }
+
+        if (scopeStack.empty())
+        {
+            return;
+        }
+
+        auto &scope = scopeStack.back();
+        if (scope.count++ > 0)
+        {
+            buffer.push_back(',');
+        }
+
+        if (pretty)
+        {
+            if (scope.singleLine)
+            {
+                buffer.push_back(' ');
+            }
+            else
+            {
+                writeNewLine(scopeStack.size());
+            }
+        }
+    }
+
+    void JSONWriter::endValue(void)
+    {
+        if (onFlush && buffer.size() >= FlushSize)
+        {
+            flush();
+        }
+    }
+
+    void JSONWriter::writeNewLine(size_t depth)
+    {
+        buffer.push_back('\n');
+        buffer.append(depth * 4, ' ');
+    }
+
+    void JSONWriter::writeQuoted(std::string_view string)
+    {
+        static const char HexadecimalList[] = "0123456789abcdef";
+
+        buffer.push_back('"');
+        auto runStart = string.data();
+        auto end = (string.data() + string.size());
+        for (auto current = runStart; current < end; ++current)
+        {
+            auto escape = Escapes.escapeList[static_cast<unsigned char>(*current)];
+            if (escape)
+            {
+                buffer.append(runStart, current);
+                buffer.push_back('\\');
+                buffer.push_back(escape);
+                if (escape == 'u')
+                {
+                    auto character = static_cast<unsigned char>(*current);
+                    buffer.append("00", 2);
+                    buffer.push_back(HexadecimalList[character >> 4]);
+                    buffer.push_back(HexadecimalList[character & 0xF]);
+                }
+
+                runStart = (current + 1);
+            }
+        }
+
+        buffer.append(runStart, end);
+        buffer.push_back('"');
+    }
+}; // namespace Gek
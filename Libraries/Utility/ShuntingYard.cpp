@@ -2,6 +2,13 @@
 #include "GEK/Utility/String.hpp"
 #include "GEK/Utility//Hash.hpp"
 #include "GEK/Math/Common.hpp"
+#include <concurrent_unordered_map.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <mutex>
+#include <shared_mutex>
 
 // https://blog.kallisti.net.rz.xyz/2008/02/extension-to-the-shunting-yard-algorithm-to-allow-variable-numbers-of-arguments-to-functions/
 namespace Gek
@@ -32,7 +39,7 @@ namespace Gek
     {
     }
 
-    ShuntingYard::Token::Token(float *variable)
+    ShuntingYard::Token::Token(uint32_t variable)
         : type(TokenType::Number)
         , variable(variable)
     {
@@ -45,7 +52,7 @@ namespace Gek
 
     ShuntingYard::Operand::Operand(Token const &token)
     {
-        if (token.variable)
+        if (token.variable != InvalidVariable)
         {
             type = OperandType::Variable;
             variable = token.variable;
@@ -69,154 +76,133 @@ namespace Gek
         this->function = function;
     }
 
-	ShuntingYard::ShuntingYard(void)
-        : mersineTwister(std::random_device()())
+    struct ShuntingYard::Library
     {
-        variableMap["pi"] = Math::Pi;
-        variableMap["tau"] = Math::Tau;
-        variableMap["e"] = Math::E;
-        variableMap["true"] = 1.0f;
-        variableMap["false"] = 0.0f;
-
-        operationsMap.insert({ "^", { 4, Associations::Right, nullptr, [](float valueLeft, float valueRight) -> float
-        {
-            return std::pow(valueLeft, valueRight);
-        } } });
-
-        operationsMap.insert({ "*", { 3, Associations::Left, nullptr, [](float valueLeft, float valueRight) -> float
-        {
-            return (valueLeft * valueRight);
-        } } });
-
-        operationsMap.insert({ "/", { 3, Associations::Left, nullptr, [](float valueLeft, float valueRight) -> float
-        {
-            return (valueLeft / valueRight);
-        } } });
-
-        operationsMap.insert({ "+", { 2, Associations::Left, [](float value) -> float
-        {
-            return value;
-        }, [](float valueLeft, float valueRight) -> float
-        {
-            return (valueLeft + valueRight);
-        } } });
-
-        operationsMap.insert({ "-", { 2, Associations::Left, [](float value) -> float
-        {
-            return -value;
-        }, [](float valueLeft, float valueRight) -> float
-        {
-            return (valueLeft - valueRight);
-        } } });
-
-        functionsMap.insert({ "sin", { 1, [](std::stack<float> &stack) -> float
-        {
-            float value = stack.top();
-            return std::sin(value);
-        } } });
+        std::unordered_map<std::string, float> constantMap;
+        std::unordered_map<std::string, Operation> operationsMap;
+        std::unordered_map<std::string, Function> functionsMap;
 
-        functionsMap.insert({ "cos", { 1, [](std::stack<float> &stack) -> float
-        {
-            float value = PopTop(stack);
-            return std::cos(value);
-        } } });
+        // Operations and functions are only changed under an exclusive lock, compiling reads them under a shared lock
+        std::shared_mutex tableMutex;
 
-        functionsMap.insert({ "tan", { 1, [](std::stack<float> &stack) -> float
-        {
-            float value = PopTop(stack);
-            return std::tan(value);
-        } } });
-
-        functionsMap.insert({ "asin", { 1, [](std::stack<float> &stack) -> float
-        {
-            float value = PopTop(stack);
-            return std::asin(value);
-        } } });
+        // Slots are only added, so contexts can hold on to them
+        concurrency::concurrent_unordered_map<std::string, uint32_t> variableMap;
+        std::mutex variableMutex;
 
-        functionsMap.insert({ "acos", { 1, [](std::stack<float> &stack) -> float
+        // Programs compiled against the current operations, functions, and variables, keyed by the expression itself
+        // Expressions that fail to compile are cached as invalid programs as well
+        struct ProgramCache
         {
-            float value = PopTop(stack);
-            return std::acos(value);
-        } } });
+            concurrency::concurrent_unordered_map<std::string, Program> programMap;
+        };
 
-        functionsMap.insert({ "atan", { 1, [](std::stack<float> &stack) -> float
-        {
-            float value = PopTop(stack);
-            return std::atan(value);
-        } } });
+        // Any change that could compile an expression differently replaces the cache after the change is made,
+        // the stale cache is released once the last program handed out from it is
+        std::shared_ptr<ProgramCache> cache = std::make_shared<ProgramCache>();
 
-        functionsMap.insert({ "min", { 2, [](std::stack<float> &stack) -> float
+        std::shared_ptr<ProgramCache> getCache(void)
         {
-            float value2 = PopTop(stack);
-            float value1 = PopTop(stack);
-            return std::min(value1, value2);
-        } } });
+            return std::atomic_load(&cache);
+        }
 
-        functionsMap.insert({ "max", { 2, [](std::stack<float> &stack) -> float
+        void resetCache(void)
         {
-            float value2 = PopTop(stack);
-            float value1 = PopTop(stack);
-            return std::max(value1, value2);
-        } } });
+            std::atomic_store(&cache, std::make_shared<ProgramCache>());
+        }
 
-        functionsMap.insert({ "abs", { 1, [](std::stack<float> &stack) -> float
-        {
-            float value = PopTop(stack);
-            return std::abs(value);
-        } } });
+        Library(void)
+        {
+            constantMap["pi"] = Math::Pi;
+            constantMap["tau"] = Math::Tau;
+            constantMap["e"] = Math::E;
+            constantMap["true"] = 1.0f;
+            constantMap["false"] = 0.0f;
+
+            // Built-in operations and functions are executed inline, so they don't need a std::function
+            operationsMap.insert({ "^", { 4, Associations::Right, nullptr, nullptr, OpCode::UnaryOperation, OpCode::Power } });
+            operationsMap.insert({ "*", { 3, Associations::Left, nullptr, nullptr, OpCode::UnaryOperation, OpCode::Multiply } });
+            operationsMap.insert({ "/", { 3, Associations::Left, nullptr, nullptr, OpCode::UnaryOperation, OpCode::Divide } });
+            operationsMap.insert({ "+", { 2, Associations::Left, nullptr, nullptr, OpCode::Identity, OpCode::Add } });
+            operationsMap.insert({ "-", { 2, Associations::Left, nullptr, nullptr, OpCode::Negate, OpCode::Subtract } });
+
+            functionsMap.insert({ "sin", { 1, nullptr, true, OpCode::Sin } });
+            functionsMap.insert({ "cos", { 1, nullptr, true, OpCode::Cos } });
+            functionsMap.insert({ "tan", { 1, nullptr, true, OpCode::Tan } });
+            functionsMap.insert({ "asin", { 1, nullptr, true, OpCode::Asin } });
+            functionsMap.insert({ "acos", { 1, nullptr, true, OpCode::Acos } });
+            functionsMap.insert({ "atan", { 1, nullptr, true, OpCode::Atan } });
+            functionsMap.insert({ "min", { 2, nullptr, true, OpCode::Min } });
+            functionsMap.insert({ "max", { 2, nullptr, true, OpCode::Max } });
+            functionsMap.insert({ "abs", { 1, nullptr, true, OpCode::Abs } });
+            functionsMap.insert({ "ceil", { 1, nullptr, true, OpCode::Ceil } });
+            functionsMap.insert({ "floor", { 1, nullptr, true, OpCode::Floor } });
+            functionsMap.insert({ "lerp", { 3, nullptr, true, OpCode::Lerp } });
+
+            // Uses the random sequence of the context that evaluates it
+            functionsMap.insert({ "random", { 2, nullptr, false, OpCode::Random } });
+        }
 
-        functionsMap.insert({ "ceil", { 1, [](std::stack<float> &stack) -> float
+        uint32_t getVariable(std::string const &name)
         {
-            float value = PopTop(stack);
-            return std::ceil(value);
-        } } });
+            auto variableSearch = variableMap.find(name);
+            if (variableSearch != std::end(variableMap))
+            {
+                return variableSearch->second;
+            }
 
-        functionsMap.insert({ "floor", { 1, [](std::stack<float> &stack) -> float
-        {
-            float value = PopTop(stack);
-            return std::floor(value);
-        } } });
+            std::lock_guard<std::mutex> lock(variableMutex);
+            variableSearch = variableMap.find(name);
+            if (variableSearch != std::end(variableMap))
+            {
+                return variableSearch->second;
+            }
 
-        functionsMap.insert({ "lerp", { 3, [](std::stack<float> &stack) -> float
-        {
-            float value3 = PopTop(stack);
-            float value2 = PopTop(stack);
-            float value1 = PopTop(stack);
-            return Math::Interpolate(value1, value2, value3);
-        } } });
+            // Words that were not variables compiled without it, so existing programs are stale
+            auto variable = uint32_t(variableMap.size());
+            variableMap.insert(std::make_pair(name, variable));
+            resetCache();
+            return variable;
+        }
+    };
 
-        functionsMap.insert({ "random", { 2, [&](std::stack<float> &stack) -> float
-        {
-            float value2 = PopTop(stack);
-            float value1 = PopTop(stack);
-            std::uniform_real_distribution<float> uniformRealDistribution(value1, value2);
-            return uniformRealDistribution(mersineTwister);
-        } } });
+    ShuntingYard::Library &ShuntingYard::GetLibrary(void)
+    {
+        static Library library;
+        return library;
     }
 
-    ShuntingYard::ShuntingYard(ShuntingYard const &shuntingYard)
-        : seed(shuntingYard.seed)
-        , variableMap(shuntingYard.variableMap)
-        , operationsMap(shuntingYard.operationsMap)
-        , functionsMap(shuntingYard.functionsMap)
-        , mersineTwister(shuntingYard.mersineTwister)
-        , cache(shuntingYard.cache)
+	ShuntingYard::ShuntingYard(void)
+        : mersineTwister(std::random_device()())
     {
     }
 
     void ShuntingYard::setVariable(std::string const &name, float value)
     {
-        variableMap[name] = value;
+        auto variable = GetLibrary().getVariable(name);
+        if (variableList.size() <= variable)
+        {
+            variableList.resize(variable + 1, 0.0f);
+            assignedList.resize(variable + 1, false);
+        }
+
+        variableList[variable] = value;
+        assignedList[variable] = true;
     }
 
     void ShuntingYard::setOperation(std::string const &name, int precedence, Associations association, std::function<float(float value)> &unaryFunction, std::function<float(float valueLeft, float valueRight)> &binaryFunction)
     {
-        operationsMap[name] = { precedence, association, unaryFunction, binaryFunction };
+        auto &library = GetLibrary();
+        std::unique_lock<std::shared_mutex> lock(library.tableMutex);
+        library.operationsMap[name] = { precedence, association, unaryFunction, binaryFunction };
+        library.resetCache();
     }
 
-    void ShuntingYard::setFunction(std::string const &name, uint32_t parameterCount, std::function<float(std::stack<float> &)> &function)
+    void ShuntingYard::setFunction(std::string const &name, uint32_t parameterCount, std::function<float(std::stack<float> &)> &function, bool deterministic)
     {
-        functionsMap[name] = { parameterCount, function };
+        auto &library = GetLibrary();
+        std::unique_lock<std::shared_mutex> lock(library.tableMutex);
+        library.functionsMap[name] = { parameterCount, function, deterministic };
+        library.resetCache();
     }
 
     void ShuntingYard::setRandomSeed(uint32_t seed)
@@ -232,50 +218,192 @@ namespace Gek
 
     std::optional<ShuntingYard::OperandList> ShuntingYard::getTokenList(std::string const &expression)
     {
-        const auto hash = GetHash(expression);
-        auto cacheSearch = cache.find(hash);
-        if (cacheSearch != std::end(cache))
+        std::shared_lock<std::shared_mutex> lock(GetLibrary().tableMutex);
+		auto infixTokenList(convertExpressionToInfix(expression));
+        if (infixTokenList)
         {
-            return cacheSearch->second;
+            return convertInfixToReversePolishNotation(infixTokenList.value());
         }
 
-		auto infixTokenList(convertExpressionToInfix(expression));
-        if (infixTokenList)
+        return std::nullopt;
+    }
+
+    ShuntingYard::Program ShuntingYard::compile(OperandList const &rpnOperandList)
+    {
+        Program program;
+
+        // One entry per value on the stack at this point, true if the value is a constant
+        std::vector<bool> constantStack;
+        for (auto const &operand : rpnOperandList)
+        {
+            Instruction instruction;
+            uint32_t parameterCount = 0;
+            bool foldable = true;
+            switch (operand.type)
+            {
+            case OperandType::Number:
+                instruction.code = OpCode::Constant;
+                instruction.value = operand.value;
+                break;
+
+            case OperandType::Variable:
+                instruction.code = OpCode::Variable;
+                instruction.variable = operand.variable;
+                if (std::find(std::begin(program.variableList), std::end(program.variableList), operand.variable) == std::end(program.variableList))
+                {
+                    program.variableList.push_back(operand.variable);
+                }
+
+                foldable = false;
+                break;
+
+            case OperandType::UnaryOperation:
+                instruction.code = operand.operation->unaryCode;
+                instruction.operation = operand.operation;
+                parameterCount = 1;
+                break;
+
+            case OperandType::BinaryOperation:
+                instruction.code = operand.operation->binaryCode;
+                instruction.operation = operand.operation;
+                parameterCount = 2;
+                break;
+
+            case OperandType::Function:
+                instruction.code = operand.function->code;
+                instruction.function = operand.function;
+                parameterCount = operand.function->parameterCount;
+                foldable = operand.function->deterministic;
+                program.deterministic = (program.deterministic && foldable);
+                break;
+
+            default:
+                return Program();
+            };
+
+            if (constantStack.size() < parameterCount)
+            {
+                return Program();
+            }
+
+            if (instruction.code == OpCode::Identity)
+            {
+                continue;
+            }
+
+            // Variables can change between evaluations, so only literal values are folded
+            // Constant parameters are always the most recent instructions, and are replaced by the result
+            auto parameterStart = (std::end(constantStack) - parameterCount);
+            bool foldConstant = (foldable && std::all_of(parameterStart, std::end(constantStack), [](bool isConstant) -> bool
+            {
+                return isConstant;
+            }));
+
+            constantStack.erase(parameterStart, std::end(constantStack));
+            program.instructionList.push_back(instruction);
+            if (foldConstant && parameterCount > 0)
+            {
+                float stack[MaximumStackSize];
+                float *stackTop = stack;
+                auto firstInstruction = (std::end(program.instructionList) - (parameterCount + 1));
+                execute(&(*firstInstruction), (&program.instructionList.back() + 1), stackTop);
+                program.instructionList.erase(firstInstruction, std::end(program.instructionList));
+
+                instruction.code = OpCode::Constant;
+                instruction.value = stack[0];
+                program.instructionList.push_back(instruction);
+            }
+
+            constantStack.push_back(foldConstant);
+            if (constantStack.size() > MaximumStackSize)
+            {
+                return Program();
+            }
+        }
+
+        if (constantStack.size() != 1)
+        {
+            return Program();
+        }
+
+        program.valid = true;
+        return program;
+    }
+
+    std::shared_ptr<ShuntingYard::Program const> ShuntingYard::getProgram(std::string const &expression)
+    {
+        auto cache = GetLibrary().getCache();
+        auto cacheSearch = cache->programMap.find(expression);
+        if (cacheSearch == std::end(cache->programMap))
         {
-            auto tokenList(convertInfixToReversePolishNotation(infixTokenList.value()));
-            if (tokenList)
+            Program program;
+            auto rpnOperandList(getTokenList(expression));
+            if (rpnOperandList)
             {
-                return cache.insert(std::make_pair(hash, tokenList.value())).first->second;
+                program = compile(rpnOperandList.value());
             }
+
+            // Another thread may have compiled the same expression first, either program is the same
+            cacheSearch = cache->programMap.insert(std::make_pair(expression, std::move(program))).first;
         }
 
-        return std::nullopt;
+        // Shares ownership of the cache, so the program stays valid if the cache is replaced while it's in use
+        return (cacheSearch->second.valid ? std::shared_ptr<Program const>(cache, &cacheSearch->second) : nullptr);
+    }
+
+    std::optional<float> ShuntingYard::evaluate(Program const &program)
+    {
+        if (!program.valid)
+        {
+            return std::nullopt;
+        }
+
+        for (auto variable : program.variableList)
+        {
+            if (variable >= assignedList.size() || !assignedList[variable])
+            {
+                return std::nullopt;
+            }
+        }
+
+        float stack[MaximumStackSize];
+        float *stackTop = stack;
+        auto instructionList = program.instructionList.data();
+        execute(instructionList, (instructionList + program.instructionList.size()), stackTop);
+        return stack[0];
     }
 
-    std::optional<float> ShuntingYard::evaluate(OperandList &rpOperandList)
+    std::optional<float> ShuntingYard::evaluate(OperandList &rpnOperandList)
     {
-		return evaluateReversePolishNotation(rpOperandList);
+        return evaluate(compile(rpnOperandList));
     }
 
     std::optional<float> ShuntingYard::evaluate(std::string const &expression)
     {
-        auto rpnOperandList = getTokenList(expression);
-        if (rpnOperandList)
+        auto program = getProgram(expression);
+        if (program)
         {
-            return evaluateReversePolishNotation(rpnOperandList.value());
+            return evaluate(*program);
         }
 
         return std::nullopt;
     }
 
+    bool ShuntingYard::isDeterministic(std::string const &expression)
+    {
+        auto program = getProgram(expression);
+        return (program ? program->deterministic : true);
+    }
+
     bool ShuntingYard::isAssociative(std::string const &token, const Associations &type)
     {
-        auto &p = operationsMap.find(token)->second;
+        auto &p = GetLibrary().operationsMap.find(token)->second;
         return p.association == type;
     }
 
     int ShuntingYard::comparePrecedence(std::string const &token1, std::string const &token2)
     {
+        auto &operationsMap = GetLibrary().operationsMap;
         auto &p1 = operationsMap.find(token1)->second;
         auto &p2 = operationsMap.find(token2)->second;
         return p1.precedence - p2.precedence;
@@ -283,6 +411,7 @@ namespace Gek
 
     ShuntingYard::Operand ShuntingYard::getOperand(Token const &token)
     {
+        auto &library = GetLibrary();
         switch (token.type)
         {
         case TokenType::Number:
@@ -292,8 +421,8 @@ namespace Gek
         case TokenType::BinaryOperation:
             if (true)
             {
-                auto &operationSearch = operationsMap.find(token.string);
-                if (operationSearch == std::end(operationsMap))
+                auto &operationSearch = library.operationsMap.find(token.string);
+                if (operationSearch == std::end(library.operationsMap))
                 {
                     return Operand();
                 }
@@ -305,8 +434,8 @@ namespace Gek
         case TokenType::Function:
             if (true)
             {
-                auto &functionSearch = functionsMap.find(token.string);
-                if (functionSearch == std::end(functionsMap))
+                auto &functionSearch = library.functionsMap.find(token.string);
+                if (functionSearch == std::end(library.functionsMap))
                 {
                     return Operand();
                 }
@@ -389,18 +518,25 @@ namespace Gek
     static const auto locale = std::locale::classic();
     std::optional<ShuntingYard::TokenList> ShuntingYard::convertExpressionToInfix(std::string const &expression)
     {
+        auto &library = GetLibrary();
         std::string runningToken;
         TokenList infixTokenList;
         auto insertWord = [&](void)
         {
-            auto variableSearch = variableMap.find(runningToken);
-            if (variableSearch != std::end(variableMap))
+            auto constantSearch = library.constantMap.find(runningToken);
+            if (constantSearch != std::end(library.constantMap))
+            {
+                insertToken(infixTokenList, Token(constantSearch->second));
+            }
+
+            auto variableSearch = library.variableMap.find(runningToken);
+            if (variableSearch != std::end(library.variableMap))
             {
-                insertToken(infixTokenList, Token(&variableSearch->second));
+                insertToken(infixTokenList, Token(variableSearch->second));
             }
 
-            auto functionSearch = functionsMap.find(runningToken);
-            if (functionSearch != std::end(functionsMap))
+            auto functionSearch = library.functionsMap.find(runningToken);
+            if (functionSearch != std::end(library.functionsMap))
             {
                 insertToken(infixTokenList, Token(TokenType::Function, functionSearch->first));
             }
@@ -413,8 +549,8 @@ namespace Gek
 
         auto insertOperation = [&](void)
         {
-            auto operationSearch = operationsMap.find(runningToken);
-            if (operationSearch != std::end(operationsMap))
+            auto operationSearch = library.operationsMap.find(runningToken);
+            if (operationSearch != std::end(library.operationsMap))
             {
                 insertToken(infixTokenList, Token(TokenType::BinaryOperation, operationSearch->first));
             }
@@ -679,84 +815,133 @@ namespace Gek
         return rpnOperandList;
     }
 
-    std::optional<float> ShuntingYard::evaluateReversePolishNotation(OperandList const &rpnOperandList)
+    // Instructions were checked when compiled, so there are always enough values on the stack
+    void ShuntingYard::execute(Instruction const *instruction, Instruction const *lastInstruction, float *&stackTop)
     {
-        if (rpnOperandList.empty())
+        for (; instruction < lastInstruction; ++instruction)
         {
-            return std::nullopt;
-        }
-
-        std::stack<float> stack;
-        for (auto const &operand : rpnOperandList)
-        {
-            switch (operand.type)
+            switch (instruction->code)
             {
-            case OperandType::Number:
-                stack.push(operand.value);
+            case OpCode::Constant:
+                *stackTop++ = instruction->value;
                 break;
 
-            case OperandType::Variable:
-                stack.push(*operand.variable);
+            case OpCode::Variable:
+                *stackTop++ = variableList[instruction->variable];
                 break;
 
-            case OperandType::UnaryOperation:
-                if (true)
-                {
-                    if (stack.empty())
-                    {
-						return std::nullopt;
-					}
+            case OpCode::Identity:
+                break;
 
-                    float functionValue = PopTop(stack);
-                    stack.push(operand.operation->unaryFunction(functionValue));
-                    break;
-                }
+            case OpCode::Negate:
+                stackTop[-1] = -stackTop[-1];
+                break;
 
-            case OperandType::BinaryOperation:
-                if (true)
-                {
-                    if (stack.empty())
-                    {
-						return std::nullopt;
-					}
+            case OpCode::Add:
+                --stackTop;
+                stackTop[-1] += stackTop[0];
+                break;
 
-                    float functionValueRight = PopTop(stack);
-                    if (stack.empty())
-                    {
-						return std::nullopt;
-					}
+            case OpCode::Subtract:
+                --stackTop;
+                stackTop[-1] -= stackTop[0];
+                break;
 
-                    float functionValueLeft = PopTop(stack);
-                    stack.push(operand.operation->binaryFunction(functionValueLeft, functionValueRight));
-                    break;
-                }
+            case OpCode::Multiply:
+                --stackTop;
+                stackTop[-1] *= stackTop[0];
+                break;
 
-            case OperandType::Function:
+            case OpCode::Divide:
+                --stackTop;
+                stackTop[-1] /= stackTop[0];
+                break;
+
+            case OpCode::Power:
+                --stackTop;
+                stackTop[-1] = std::pow(stackTop[-1], stackTop[0]);
+                break;
+
+            case OpCode::Sin:
+                stackTop[-1] = std::sin(stackTop[-1]);
+                break;
+
+            case OpCode::Cos:
+                stackTop[-1] = std::cos(stackTop[-1]);
+                break;
+
+            case OpCode::Tan:
+                stackTop[-1] = std::tan(stackTop[-1]);
+                break;
+
+            case OpCode::Asin:
+                stackTop[-1] = std::asin(stackTop[-1]);
+                break;
+
+            case OpCode::Acos:
+                stackTop[-1] = std::acos(stackTop[-1]);
+                break;
+
+            case OpCode::Atan:
+                stackTop[-1] = std::atan(stackTop[-1]);
+                break;
+
+            case OpCode::Min:
+                --stackTop;
+                stackTop[-1] = std::min(stackTop[-1], stackTop[0]);
+                break;
+
+            case OpCode::Max:
+                --stackTop;
+                stackTop[-1] = std::max(stackTop[-1], stackTop[0]);
+                break;
+
+            case OpCode::Abs:
+                stackTop[-1] = std::abs(stackTop[-1]);
+                break;
+
+            case OpCode::Ceil:
+                stackTop[-1] = std::ceil(stackTop[-1]);
+                break;
+
+            case OpCode::Floor:
+                stackTop[-1] = std::floor(stackTop[-1]);
+                break;
+
+            case OpCode::Lerp:
+                stackTop -= 2;
+                stackTop[-1] = Math::Interpolate(stackTop[-1], stackTop[0], stackTop[1]);
+                break;
+
+            case OpCode::Random:
                 if (true)
                 {
-                    if (stack.size() < operand.function->parameterCount)
-                    {
-						return std::nullopt;
-					}
-
-                    stack.push(operand.function->function(stack));
+                    --stackTop;
+                    std::uniform_real_distribution<float> uniformRealDistribution(stackTop[-1], stackTop[0]);
+                    stackTop[-1] = uniformRealDistribution(mersineTwister);
                     break;
                 }
 
-            default:
-				return std::nullopt;
-			};
-        }
+            case OpCode::UnaryOperation:
+                stackTop[-1] = instruction->operation->unaryFunction(stackTop[-1]);
+                break;
 
-        if (stack.empty())
-        {
-            return std::nullopt;
-        }
-        else if (stack.size() != 1)
-        {
-			return std::nullopt;
-		}
+            case OpCode::BinaryOperation:
+                --stackTop;
+                stackTop[-1] = instruction->operation->binaryFunction(stackTop[-1], stackTop[0]);
+                break;
 
-		return stack.top();
+            case OpCode::Function:
+                if (true)
+                {
+                    // Registered functions take their parameters from a stack, last parameter on top
+                    auto parameterCount = instruction->function->parameterCount;
+                    std::stack<float> parameterStack(std::deque<float>(stackTop - parameterCount, stackTop));
+                    stackTop -= parameterCount;
+                    *stackTop++ = instruction->function->function(parameterStack);
+                    break;
+                }
+            };
+        }
     }
 }; // namespace Gek
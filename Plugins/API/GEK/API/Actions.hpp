@@ -0,0 +1,48 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/Hash.hpp"
+#include "GEK/API/Population.hpp"
+
+namespace Gek
+{
+    namespace Actions
+    {
+        using Identifier = Plugin::Population::ActionIdentifier;
+
+        // The same value getActionIdentifier returns, names are expected to be lower case
+        constexpr Identifier GetIdentifier(std::string_view name)
+        {
+            return GetStableHash(name);
+        }
+
+        // Actions sent by the core from the keyboard and mouse
+        static constexpr Identifier MoveForward = GetIdentifier("move_forward");
+        static constexpr Identifier MoveBackward = GetIdentifier("move_backward");
+        static constexpr Identifier StrafeLeft = GetIdentifier("strafe_left");
+        static constexpr Identifier StrafeRight = GetIdentifier("strafe_right");
+        static constexpr Identifier Jump = GetIdentifier("jump");
+        static constexpr Identifier Crouch = GetIdentifier("crouch");
+        static constexpr Identifier Turn = GetIdentifier("turn");
+        static constexpr Identifier Tilt = GetIdentifier("tilt");
+
+        // Registered by the population so that getActionName works for actions that are never looked up by name
+        static constexpr std::string_view NameList[] =
+        {
+            "move_forward",
+            "move_backward",
+            "strafe_left",
+            "strafe_right",
+            "jump",
+            "crouch",
+            "turn",
+            "tilt",
+        };
+    }; // namespace Actions
+}; // namespace Gek
@@ -9,6 +9,8 @@
 
 #include "GEK/Utility/Context.hpp"
 #include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/Allocator.hpp"
+#include "GEK/Utility/Binary.hpp"
 
 #pragma warning(disable:4503)
 
@@ -28,6 +30,29 @@ static std::string_view GetName(void) \
 static Hash GetIdentifier(void) \
 { \
 	return typeid(TYPE).hash_code(); \
+} \
+\
+static Gek::BlockPool &GetPool(void) \
+{ \
+	static Gek::BlockPool pool(sizeof(TYPE), alignof(TYPE)); \
+	return pool; \
+} \
+\
+static void *operator new(std::size_t size) \
+{ \
+	return (size == sizeof(TYPE) ? GetPool().allocate() : ::operator new(size)); \
+} \
+\
+static void operator delete(void *data, std::size_t size) \
+{ \
+	if (size == sizeof(TYPE)) \
+	{ \
+		GetPool().free(data); \
+	} \
+	else \
+	{ \
+		::operator delete(data); \
+	} \
 }
 
 namespace Gek
@@ -49,8 +74,24 @@ namespace Gek
             virtual Hash getIdentifier(void) const = 0;
 
             virtual std::unique_ptr<Data> create(void) = 0;
+
+            // Copies loaded data, used to stamp out instances of a shared prototype without reloading them
+            virtual std::unique_ptr<Data> clone(Data const * const data) = 0;
+
+            // False if loading the same definition twice can produce different data, such as when it calls random()
+            virtual bool isDeterministic(JSON const &importData) = 0;
+
+            // Component data is allocated from a pool per type, releasePool destroys every instance in one walk
+            // over the pool's slabs and returns them, so anything still pointing at the data must drop it unfreed
+            virtual BlockPool::Statistics getPoolStatistics(void) const = 0;
+            virtual void releasePool(void) = 0;
+
             virtual void save(Data const * const data, JSON &exportData) const = 0;
             virtual void load(Data * const data, JSON const &exportData) = 0;
+
+            // Binary snapshot serialisers, load must read back exactly what save wrote
+            virtual void save(Data const * const data, BinaryWriter &exportData) const = 0;
+            virtual void load(Data * const data, BinaryReader &importData) = 0;
         };
     }; // namespace Plugin
 }; // namespace Gek
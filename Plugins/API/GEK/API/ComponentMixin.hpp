@@ -11,6 +11,7 @@
 #include "GEK/API/Processor.hpp"
 #include "GEK/API/Population.hpp"
 #include <concurrent_unordered_map.h>
+#include <type_traits>
 #include <new>
 
 namespace Gek
@@ -50,6 +51,36 @@ namespace Gek
                 return std::make_unique<COMPONENT>();
             }
 
+            std::unique_ptr<Plugin::Component::Data> clone(Plugin::Component::Data const * const data)
+            {
+                return std::make_unique<COMPONENT>(*static_cast<COMPONENT const * const>(data));
+            }
+
+            virtual bool isDeterministic(JSON const &importData)
+            {
+                return importData.isDeterministic(population->getShuntingYard());
+            }
+
+            BlockPool::Statistics getPoolStatistics(void) const
+            {
+                return COMPONENT::GetPool().getStatistics();
+            }
+
+            void releasePool(void)
+            {
+                if constexpr (std::is_trivially_destructible<COMPONENT>::value)
+                {
+                    COMPONENT::GetPool().release();
+                }
+                else
+                {
+                    COMPONENT::GetPool().release([](void *data) -> void
+                    {
+                        static_cast<COMPONENT *>(data)->~COMPONENT();
+                    });
+                }
+            }
+
             template <typename TYPE>
             TYPE evaluate(JSON const &object, TYPE defaultValue)
             {
@@ -59,6 +90,9 @@ namespace Gek
             virtual void save(COMPONENT const * const component, JSON &exportData) const { };
             virtual void load(COMPONENT * const component, JSON const &importData) { };
 
+            virtual void save(COMPONENT const * const component, BinaryWriter &exportData) const { };
+            virtual void load(COMPONENT * const component, BinaryReader &importData) { };
+
             void save(Plugin::Component::Data const * const component, JSON &exportData) const
             {
                 save(static_cast<COMPONENT const * const>(component), exportData);
@@ -69,6 +103,16 @@ namespace Gek
                 load(static_cast<COMPONENT * const>(component), importData);
             }
 
+            void save(Plugin::Component::Data const * const component, BinaryWriter &exportData) const
+            {
+                save(static_cast<COMPONENT const * const>(component), exportData);
+            }
+
+            void load(Plugin::Component::Data * const component, BinaryReader &importData)
+            {
+                load(static_cast<COMPONENT * const>(component), importData);
+            }
+
             bool editorElement(std::string_view const &text, std::function<bool(void)> &&element)
             {
                 ImGui::AlignFirstTextHeightToWidgets();
@@ -129,6 +173,38 @@ namespace Gek
                 }
             }
 
+            // The required mask is looked up once per batch, each entity is then a single mask test
+            void addEntities(Plugin::Population *population, Plugin::Population::EntityBatch const &entityBatch, std::function<void(bool isNewInsert, Data &data, REQUIRED&... components)> onAdded = nullptr)
+            {
+                assert(population);
+
+                static const Data BlankData;
+                const auto requiredMask = population->getComponentMask<REQUIRED...>();
+                for (auto &entity : entityBatch)
+                {
+                    if (entity->hasComponentMask(requiredMask))
+                    {
+                        auto insertSearch = entityDataMap.insert(std::make_pair(entity, BlankData));
+                        if (onAdded)
+                        {
+                            onAdded(insertSearch.second, insertSearch.first->second, entity->getComponent<REQUIRED>()...);
+                        }
+                    }
+                }
+            }
+
+            void removeEntities(Plugin::Population::EntityBatch const &entityBatch)
+            {
+                for (auto &entity : entityBatch)
+                {
+                    auto entitySearch = entityDataMap.find(entity);
+                    if (entitySearch != std::end(entityDataMap))
+                    {
+                        entityDataMap.unsafe_erase(entitySearch);
+                    }
+                }
+            }
+
             size_t getEntityCount(void)
             {
                 return entityDataMap.size();
@@ -11,6 +11,7 @@
 #include "GEK/Utility/JSON.hpp"
 #include <wink/signal.hpp>
 #include <imgui.h>
+#include <atomic>
 
 namespace Gek
 {
@@ -25,12 +26,20 @@ namespace Gek
         {
             virtual ~Core(void) = default;
 
+            // Shared by every handle to the same option, and kept for the lifetime of the core
+            // setOption and deleteOption emit the new value, which is null once deleted
+            struct OptionState
+            {
+                wink::signal<wink::slot<void(JSON const &value)>> onChanged;
+            };
+
             wink::signal<wink::slot<void(void)>> onInitialized;
             wink::signal<wink::slot<void(void)>> onShutdown;
 
             virtual JSON getOption(std::string_view system, std::string_view name) const = 0;
             virtual void setOption(std::string_view system, std::string_view name, JSON const &value) = 0;
             virtual void deleteOption(std::string_view system, std::string_view name) = 0;
+            virtual OptionState *getOptionState(std::string_view system, std::string_view name) = 0;
 
             virtual Plugin::Population * getPopulation(void) const = 0;
             virtual Plugin::Resources * getResources(void) const = 0;
@@ -38,5 +47,63 @@ namespace Gek
 
             virtual void listProcessors(std::function<void(Plugin::Processor *)> onProcessor) = 0;
         };
+
+        // A typed option resolved once by system and name, so reading it every frame is a single atomic load
+        // The value follows setOption, and onChanged is emitted when the converted value changes
+        template <typename TYPE>
+        class Option
+        {
+        private:
+            Core::OptionState *state = nullptr;
+            TYPE defaultValue = TYPE();
+            std::atomic<TYPE> value = TYPE();
+
+        public:
+            wink::signal<wink::slot<void(TYPE value)>> onChanged;
+
+        public:
+            Option(void) = default;
+            Option(Option const &) = delete;
+
+            ~Option(void)
+            {
+                disconnect();
+            }
+
+            void connect(Core *core, std::string_view system, std::string_view name, TYPE defaultValue)
+            {
+                assert(core);
+
+                disconnect();
+                this->defaultValue = defaultValue;
+                value = core->getOption(system, name).convert(defaultValue);
+                state = core->getOptionState(system, name);
+                state->onChanged.connect(this, &Option::onOptionChanged);
+            }
+
+            void disconnect(void)
+            {
+                if (state)
+                {
+                    state->onChanged.disconnect(this, &Option::onOptionChanged);
+                    state = nullptr;
+                }
+            }
+
+            TYPE get(void) const
+            {
+                return value.load(std::memory_order_relaxed);
+            }
+
+        private:
+            void onOptionChanged(JSON const &newValue)
+            {
+                const TYPE convertedValue = newValue.convert(defaultValue);
+                if (value.exchange(convertedValue) != convertedValue)
+                {
+                    onChanged.emit(convertedValue);
+                }
+            }
+        };
     }; // namespace Plugin
 }; // namespace Gek
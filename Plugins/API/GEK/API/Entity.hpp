@@ -17,11 +17,20 @@ namespace Gek
 {
     namespace Plugin
     {
+        // One bit per component type, assigned by the population when the component plugins load
+        using ComponentMask = uint64_t;
+
         GEK_INTERFACE(Entity)
         {
             virtual ~Entity(void) = default;
 
             virtual bool hasComponent(Hash type) const = 0;
+            virtual ComponentMask getComponentMask(void) const = 0;
+
+            bool hasComponentMask(ComponentMask mask) const
+            {
+                return ((getComponentMask() & mask) == mask);
+            }
 
 			virtual Plugin::Component::Data *getComponent(Hash type) = 0;
 			virtual const Plugin::Component::Data *getComponent(Hash type) const = 0;
@@ -10,10 +10,12 @@
 #include "GEK/Utility/String.hpp"
 #include "GEK/Utility/Context.hpp"
 #include "GEK/Utility/ShuntingYard.hpp"
+#include "GEK/Math/Vector3.hpp"
 #include "GEK/API/Entity.hpp"
 #include <wink/signal.hpp>
 #include <functional>
 #include <typeindex>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
@@ -29,27 +31,33 @@ namespace Gek
             using EntityDefinition = std::unordered_map<std::string, JSON>;
             using ComponentDefinition = EntityDefinition::value_type;
 
+            // Stable hash of the lower case action name, well known actions are constants in GEK/API/Actions.hpp
+            using ActionIdentifier = uint64_t;
+
             struct Action
             {
-                std::string name;
+                ActionIdentifier identifier = 0;
                 union
                 {
                     bool state;
                     float value;
                 };
 
+                // The whole union is cleared first so recorded sessions write the same bytes for bool actions
                 Action(void)
+                    : value(0.0f)
                 {
                 }
 
-                Action(std::string const &name, bool state)
-                    : name(String::GetLower(name))
-                    , state(state)
+                Action(ActionIdentifier identifier, bool state)
+                    : identifier(identifier)
+                    , value(0.0f)
                 {
+                    this->state = state;
                 }
 
-                Action(std::string const &name, float value)
-					: name(String::GetLower(name))
+                Action(ActionIdentifier identifier, float value)
+					: identifier(identifier)
 					, value(value)
                 {
                 }
@@ -58,7 +66,9 @@ namespace Gek
             virtual ~Population(void) = default;
 
             std::map<int32_t, wink::signal<wink::slot<void(float frameTime)>>> onUpdate;
-            wink::signal<wink::slot<void(Action const &action)>> onAction;
+
+            // Listeners connect to the actions they handle, each action is only sent to its own signal
+            std::unordered_map<ActionIdentifier, wink::signal<wink::slot<void(Action const &action)>>> onAction;
 
             wink::signal<wink::slot<void(void)>> onReset;
 
@@ -68,16 +78,41 @@ namespace Gek
             wink::signal<wink::slot<void(Plugin::Entity * const entity)>> onComponentAdded;
             wink::signal<wink::slot<void(Plugin::Entity * const entity)>> onComponentRemoved;
 
+            // Batched versions of the signals above, sent once per run of the same change when commands are applied
+            // Entities are still valid while the destroyed batch is sent, and components while the removed batch is
+            using EntityBatch = std::vector<Plugin::Entity *>;
+            wink::signal<wink::slot<void(EntityBatch const &entityBatch)>> onEntitiesCreated;
+            wink::signal<wink::slot<void(EntityBatch const &entityBatch)>> onEntitiesDestroyed;
+
+            wink::signal<wink::slot<void(EntityBatch const &entityBatch)>> onComponentsAdded;
+            wink::signal<wink::slot<void(EntityBatch const &entityBatch)>> onComponentsRemoved;
+
             virtual ShuntingYard &getShuntingYard(void) = 0;
 
+            // Names are case insensitive, the same name always returns the same identifier
+            virtual ActionIdentifier getActionIdentifier(std::string_view name) = 0;
+            virtual std::string_view getActionName(ActionIdentifier identifier) const = 0;
+
+            virtual ComponentMask getComponentMask(Hash type) const = 0;
+
+            template <typename... COMPONENTS>
+            ComponentMask getComponentMask(void) const
+            {
+                return (getComponentMask(COMPONENTS::GetIdentifier()) | ...);
+            }
+
             virtual void load(std::string const &populationName) = 0;
             virtual void save(std::string const &populationName) = 0;
 
-            virtual Plugin::Entity *createEntity(EntityDefinition const &definition) = 0;
-            virtual void killEntity(Plugin::Entity * const entity) = 0;
+            // Entity and component changes are recorded into per-thread command buffers and applied at
+            // the end of the next update, after any loaded or streamed entities, sorted by key and then
+            // by the order they were issued. Parallel producers should pass a key unique to the work item
+            // to get a reproducible order.
+            virtual Plugin::Entity *createEntity(EntityDefinition const &definition, uint64_t sortKey = 0) = 0;
+            virtual void killEntity(Plugin::Entity * const entity, uint64_t sortKey = 0) = 0;
 
-            virtual void addComponent(Plugin::Entity * const entity, ComponentDefinition const &definition) = 0;
-            virtual void removeComponent(Plugin::Entity * const entity, Hash type) = 0;
+            virtual void addComponent(Plugin::Entity * const entity, ComponentDefinition const &definition, uint64_t sortKey = 0) = 0;
+            virtual void removeComponent(Plugin::Entity * const entity, Hash type, uint64_t sortKey = 0) = 0;
 
             virtual void listEntities(std::function<void(Plugin::Entity * const entity)> onEntity) const = 0;
 
@@ -94,6 +129,9 @@ namespace Gek
             }
 
             virtual void action(Action const &action) = 0;
+
+            // Partitioned scenes stream cells in and out around the viewers added each frame, such as active cameras
+            virtual void addStreamingViewer(Math::Float3 const &position) = 0;
         };
     }; // namespace Plugin
 }; // namespace Gek
\ No newline at end of file
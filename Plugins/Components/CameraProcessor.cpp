@@ -56,6 +56,22 @@ namespace Gek
             data->target = evaluate(importData.getMember("target"sv), String::Empty);
         }
 
+        void save(Components::FirstPersonCamera const * const data, BinaryWriter &exportData) const
+        {
+            exportData.write(data->fieldOfView);
+            exportData.write(data->nearClip);
+            exportData.write(data->farClip);
+            exportData.writeString(data->target);
+        }
+
+        void load(Components::FirstPersonCamera * const data, BinaryReader &importData)
+        {
+            importData.read(data->fieldOfView);
+            importData.read(data->nearClip);
+            importData.read(data->farClip);
+            data->target = importData.readString();
+        }
+
         // Edit::Component
         bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
         {
@@ -98,6 +114,7 @@ namespace Gek
         Plugin::Population *population = nullptr;
         Plugin::Resources *resources = nullptr;
         Plugin::Renderer *renderer = nullptr;
+        Plugin::Option<bool> editorActive;
 
     public:
         CameraProcessor(Context *context, Plugin::Core *core)
@@ -111,18 +128,19 @@ namespace Gek
             assert(resources);
             assert(renderer);
 
+            editorActive.connect(core, "editor"sv, "active"sv, false);
             core->onShutdown.connect(this, &CameraProcessor::onShutdown);
             population->onReset.connect(this, &CameraProcessor::onReset);
-            population->onEntityCreated.connect(this, &CameraProcessor::onEntityCreated);
-            population->onEntityDestroyed.connect(this, &CameraProcessor::onEntityDestroyed);
-            population->onComponentAdded.connect(this, &CameraProcessor::onComponentAdded);
-            population->onComponentRemoved.connect(this, &CameraProcessor::onComponentRemoved);
+            population->onEntitiesCreated.connect(this, &CameraProcessor::onEntitiesCreated);
+            population->onEntitiesDestroyed.connect(this, &CameraProcessor::onEntitiesDestroyed);
+            population->onComponentsAdded.connect(this, &CameraProcessor::onComponentsAdded);
+            population->onComponentsRemoved.connect(this, &CameraProcessor::onComponentsRemoved);
             population->onUpdate[90].connect(this, &CameraProcessor::onUpdate);
         }
 
-        void addEntity(Plugin::Entity * const entity)
+        void addEntities(Plugin::Population::EntityBatch const &entityBatch)
         {
-            EntityProcessor::addEntity(entity, [&](bool isNewInsert, auto &data, auto &cameraComponent, auto &transformComponent) -> void
+            EntityProcessor::addEntities(population, entityBatch, [&](bool isNewInsert, auto &data, auto &cameraComponent, auto &transformComponent) -> void
             {
                 if (!cameraComponent.target.empty())
                 {
@@ -141,10 +159,10 @@ namespace Gek
         void onShutdown(void)
         {
             population->onReset.disconnect(this, &CameraProcessor::onReset);
-            population->onEntityCreated.disconnect(this, &CameraProcessor::onEntityCreated);
-            population->onEntityDestroyed.disconnect(this, &CameraProcessor::onEntityDestroyed);
-            population->onComponentAdded.disconnect(this, &CameraProcessor::onComponentAdded);
-            population->onComponentRemoved.disconnect(this, &CameraProcessor::onComponentRemoved);
+            population->onEntitiesCreated.disconnect(this, &CameraProcessor::onEntitiesCreated);
+            population->onEntitiesDestroyed.disconnect(this, &CameraProcessor::onEntitiesDestroyed);
+            population->onComponentsAdded.disconnect(this, &CameraProcessor::onComponentsAdded);
+            population->onComponentsRemoved.disconnect(this, &CameraProcessor::onComponentsRemoved);
             population->onUpdate[90].disconnect(this, &CameraProcessor::onUpdate);
             clear();
         }
@@ -155,24 +173,24 @@ namespace Gek
             clear();
         }
 
-        void onEntityCreated(Plugin::Entity * const entity)
+        void onEntitiesCreated(Plugin::Population::EntityBatch const &entityBatch)
         {
-            addEntity(entity);
+            addEntities(entityBatch);
         }
 
-        void onEntityDestroyed(Plugin::Entity * const entity)
+        void onEntitiesDestroyed(Plugin::Population::EntityBatch const &entityBatch)
         {
-            removeEntity(entity);
+            removeEntities(entityBatch);
         }
 
-        void onComponentAdded(Plugin::Entity * const entity)
+        void onComponentsAdded(Plugin::Population::EntityBatch const &entityBatch)
         {
-            addEntity(entity);
+            addEntities(entityBatch);
         }
 
-        void onComponentRemoved(Plugin::Entity * const entity)
+        void onComponentsRemoved(Plugin::Population::EntityBatch const &entityBatch)
         {
-            removeEntity(entity);
+            removeEntities(entityBatch);
         }
 
         // Plugin::Population Slots
@@ -180,8 +198,7 @@ namespace Gek
         {
             assert(renderer);
 
-			bool editorActive = core->getOption("editor", "active").convert(false);
-			if (frameTime > 0.0f && !editorActive)
+			if (frameTime > 0.0f && !editorActive.get())
 			{
 				parallelListEntities([&](Plugin::Entity * const entity, auto &data, auto &cameraComponent, auto &transformComponent) -> void
 				{
@@ -196,7 +213,8 @@ namespace Gek
 						name = String::Format("camera_{}", *reinterpret_cast<int *>(entity));
 					}
 
-					auto viewMatrix(transformComponent.getMatrix().getInverse());
+					population->addStreamingViewer(transformComponent.getWorldPosition());
+					auto viewMatrix(transformComponent.getWorldMatrix().getInverse());
 
 					const auto backBuffer = core->getRenderer()->getVideoDevice()->getBackBuffer();
 					const float width = float(backBuffer->getDescription().width);
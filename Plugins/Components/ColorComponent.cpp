@@ -33,6 +33,16 @@ namespace Gek
             data->value = evaluate(importData, Math::Float4::White);
         }
 
+        void save(Components::Color const * const data, BinaryWriter &exportData) const
+        {
+            exportData.write(data->value.data);
+        }
+
+        void load(Components::Color * const data, BinaryReader &importData)
+        {
+            importData.read(data->value.data);
+        }
+
         // Edit::Component
         bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
         {
@@ -24,6 +24,17 @@ namespace Gek
             Math::Quaternion rotation = Math::Quaternion::Identity;
             Math::Float3 scale = Math::Float3::One;
 
+            // Name of the parent entity, position and rotation are relative to it
+            // Scale is not inherited by children
+            std::string parent;
+
+            // Maintained by the transform processor
+            Plugin::Entity *parentEntity = nullptr;
+            uint32_t depth = 0;
+            bool dirty = true;
+            Math::Float4x4 localMatrix = Math::Float4x4::Identity;
+            Math::Float4x4 worldMatrix = Math::Float4x4::Identity;
+
             inline Math::Float4x4 getMatrix(void) const
             {
                 return Math::Float4x4::MakeQuaternionRotation(rotation, position);
@@ -33,6 +44,21 @@ namespace Gek
             {
                 return (Math::Float4x4::MakeScaling(scale) * getMatrix());
             }
+
+            inline Math::Float4x4 const &getWorldMatrix(void) const
+            {
+                return worldMatrix;
+            }
+
+            inline Math::Float4x4 getScaledWorldMatrix(void) const
+            {
+                return (Math::Float4x4::MakeScaling(scale) * worldMatrix);
+            }
+
+            inline Math::Float3 getWorldPosition(void) const
+            {
+                return worldMatrix.translation.xyz;
+            }
         };
     }; // namespace Components
 }; // namespace Gek
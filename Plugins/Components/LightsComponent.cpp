@@ -32,6 +32,20 @@ namespace Gek
             LockedWrite{ std::cout } << "Range: " << data->range << ", Radius: " << data->radius << ", Intensity: " << data->intensity;
         }
 
+        void save(Components::PointLight const * const data, BinaryWriter &exportData) const
+        {
+            exportData.write(data->range);
+            exportData.write(data->radius);
+            exportData.write(data->intensity);
+        }
+
+        void load(Components::PointLight * const data, BinaryReader &importData)
+        {
+            importData.read(data->range);
+            importData.read(data->radius);
+            importData.read(data->intensity);
+        }
+
         // Edit::Component
         bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
         {
@@ -91,6 +105,26 @@ namespace Gek
             data->coneFalloff = evaluate(importData.getMember("coneFalloff"sv), 0.0f);
         }
 
+        void save(Components::SpotLight const * const data, BinaryWriter &exportData) const
+        {
+            exportData.write(data->range);
+            exportData.write(data->radius);
+            exportData.write(data->intensity);
+            exportData.write(data->innerAngle);
+            exportData.write(data->outerAngle);
+            exportData.write(data->coneFalloff);
+        }
+
+        void load(Components::SpotLight * const data, BinaryReader &importData)
+        {
+            importData.read(data->range);
+            importData.read(data->radius);
+            importData.read(data->intensity);
+            importData.read(data->innerAngle);
+            importData.read(data->outerAngle);
+            importData.read(data->coneFalloff);
+        }
+
         // Edit::Component
         bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
         {
@@ -155,6 +189,16 @@ namespace Gek
             data->intensity = evaluate(importData.getMember("intensity"sv), 0.0f);
         }
 
+        void save(Components::DirectionalLight const * const data, BinaryWriter &exportData) const
+        {
+            exportData.write(data->intensity);
+        }
+
+        void load(Components::DirectionalLight * const data, BinaryReader &importData)
+        {
+            importData.read(data->intensity);
+        }
+
         // Edit::Component
         bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
         {
@@ -29,6 +29,16 @@ namespace Gek
             data->name = importData.convert(String::Empty);
         }
 
+        void save(Components::Name const * const data, BinaryWriter &exportData) const
+        {
+            exportData.writeString(data->name);
+        }
+
+        void load(Components::Name * const data, BinaryReader &importData)
+        {
+            data->name = importData.readString();
+        }
+
         // Edit::Component
         bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
         {
@@ -75,10 +85,10 @@ namespace Gek
             core->onInitialized.connect(this, &NameProcessor::onInitialized);
             core->onShutdown.connect(this, &NameProcessor::onShutdown);
             population->onReset.connect(this, &NameProcessor::onReset);
-            population->onEntityCreated.connect(this, &NameProcessor::onEntityCreated);
-            population->onEntityDestroyed.connect(this, &NameProcessor::onEntityDestroyed);
-            population->onComponentAdded.connect(this, &NameProcessor::onComponentAdded);
-            population->onComponentRemoved.connect(this, &NameProcessor::onComponentRemoved);
+            population->onEntitiesCreated.connect(this, &NameProcessor::onEntitiesCreated);
+            population->onEntitiesDestroyed.connect(this, &NameProcessor::onEntitiesDestroyed);
+            population->onComponentsAdded.connect(this, &NameProcessor::onComponentsAdded);
+            population->onComponentsRemoved.connect(this, &NameProcessor::onComponentsRemoved);
         }
 
         uint32_t uniqueIdentifier = 0;
@@ -147,15 +157,21 @@ namespace Gek
             }
 
             population->onReset.disconnect(this, &NameProcessor::onReset);
-            population->onEntityCreated.disconnect(this, &NameProcessor::onEntityCreated);
-            population->onEntityDestroyed.disconnect(this, &NameProcessor::onEntityDestroyed);
-            population->onComponentAdded.disconnect(this, &NameProcessor::onComponentAdded);
-            population->onComponentRemoved.disconnect(this, &NameProcessor::onComponentRemoved);
+            population->onEntitiesCreated.disconnect(this, &NameProcessor::onEntitiesCreated);
+            population->onEntitiesDestroyed.disconnect(this, &NameProcessor::onEntitiesDestroyed);
+            population->onComponentsAdded.disconnect(this, &NameProcessor::onComponentsAdded);
+            population->onComponentsRemoved.disconnect(this, &NameProcessor::onComponentsRemoved);
         }
 
-        // Model::Processor
+        // Processor::Name
         Plugin::Entity *getEntity(std::string const &name)
         {
+            auto nameSearch = nameMap.find(name);
+            if (nameSearch != std::end(nameMap))
+            {
+                return nameSearch->second;
+            }
+
             return nullptr;
         }
 
@@ -174,24 +190,36 @@ namespace Gek
             clear();
         }
 
-        void onEntityCreated(Plugin::Entity * const entity)
+        void onEntitiesCreated(Plugin::Population::EntityBatch const &entityBatch)
         {
-            addEntity(entity);
+            for (auto &entity : entityBatch)
+            {
+                addEntity(entity);
+            }
         }
 
-        void onEntityDestroyed(Plugin::Entity * const entity)
+        void onEntitiesDestroyed(Plugin::Population::EntityBatch const &entityBatch)
         {
-            removeEntity(entity);
+            for (auto &entity : entityBatch)
+            {
+                removeEntity(entity);
+            }
         }
 
-        void onComponentAdded(Plugin::Entity * const entity)
+        void onComponentsAdded(Plugin::Population::EntityBatch const &entityBatch)
         {
-            addEntity(entity);
+            for (auto &entity : entityBatch)
+            {
+                addEntity(entity);
+            }
         }
 
-        void onComponentRemoved(Plugin::Entity * const entity)
+        void onComponentsRemoved(Plugin::Population::EntityBatch const &entityBatch)
         {
-            removeEntity(entity);
+            for (auto &entity : entityBatch)
+            {
+                removeEntity(entity);
+            }
         }
     };
 
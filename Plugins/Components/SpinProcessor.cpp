@@ -44,6 +44,21 @@ namespace Gek
 			data->torque.y = population->getShuntingYard().evaluate("random(-pi,pi)").value_or(0.0f);
 			data->torque.z = population->getShuntingYard().evaluate("random(-pi,pi)").value_or(0.0f);
 		}
+
+		void save(Components::Spin const * const data, BinaryWriter &exportData) const
+		{
+			exportData.write(data->torque.data);
+		}
+
+		void load(Components::Spin * const data, BinaryReader &importData)
+		{
+			importData.read(data->torque.data);
+		}
+
+		bool isDeterministic(JSON const &importData)
+		{
+			return false;
+		}
 	};
 
 	GEK_CONTEXT_USER(SpinProcessor, Plugin::Core *)
@@ -52,6 +67,7 @@ namespace Gek
 	private:
 		Plugin::Core *core = nullptr;
 		Plugin::Population *population = nullptr;
+		Plugin::Option<bool> editorActive;
 
 	public:
 		SpinProcessor(Context *context, Plugin::Core *core)
@@ -61,6 +77,7 @@ namespace Gek
 		{
 			assert(population);
 
+			editorActive.connect(core, "editor"sv, "active"sv, false);
 			core->onShutdown.connect(this, &SpinProcessor::onShutdown);
 			population->onUpdate[50].connect(this, &SpinProcessor::onUpdate);
 		}
@@ -76,8 +93,7 @@ namespace Gek
 		{
 			assert(population);
 
-			bool editorActive = core->getOption("editor", "active").convert(false);
-			if (frameTime > 0.0f && !editorActive)
+			if (frameTime > 0.0f && !editorActive.get())
 			{
 				population->listEntities<Components::Transform, Components::Spin>([&](Plugin::Entity * const entity, auto &transformComponent, auto &spinComponent) -> void
 				{
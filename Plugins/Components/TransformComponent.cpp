@@ -22,7 +22,11 @@ namespace Gek
         {
 			exportData["position"] = JSON::Array({ data->position.x, data->position.y, data->position.z });
             exportData["rotation"] = JSON::Array({ data->rotation.x, data->rotation.y, data->rotation.z, data->rotation.w });
-            exportData["scale"] = JSON::Array({ data->position.x, data->position.y, data->position.z });
+            exportData["scale"] = JSON::Array({ data->scale.x, data->scale.y, data->scale.z });
+            if (!data->parent.empty())
+            {
+                exportData["parent"] = data->parent;
+            }
         }
 
         void load(Components::Transform * const data, JSON const &importData)
@@ -30,9 +34,30 @@ namespace Gek
             data->position = evaluate(importData.getMember("position"sv), Math::Float3::Zero);
             data->rotation = evaluate(importData.getMember("rotation"sv), Math::Quaternion::Identity);
             data->scale = evaluate(importData.getMember("scale"sv), Math::Float3::One);
+            data->parent = importData.getMember("parent"sv).convert(String::Empty);
+            data->localMatrix = data->worldMatrix = data->getMatrix();
+            data->dirty = true;
             LockedWrite{ std::cout } << "Position: [" << data->position.x << ", " << data->position.y << ", " << data->position.z << "]";
         }
 
+        void save(Components::Transform const * const data, BinaryWriter &exportData) const
+        {
+            exportData.write(data->position.data);
+            exportData.write(data->rotation.data);
+            exportData.write(data->scale.data);
+            exportData.writeString(data->parent);
+        }
+
+        void load(Components::Transform * const data, BinaryReader &importData)
+        {
+            importData.read(data->position.data);
+            importData.read(data->rotation.data);
+            importData.read(data->scale.data);
+            data->parent = importData.readString();
+            data->localMatrix = data->worldMatrix = data->getMatrix();
+            data->dirty = true;
+        }
+
         // Edit::Component
         bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
         {
@@ -56,6 +81,11 @@ namespace Gek
                 return ImGui::InputFloat3("##scale", transformComponent.scale.data, 4, ImGuiInputTextFlags_CharsDecimal | ImGuiInputTextFlags_CharsNoBlank);
             });
 
+            changed |= editorElement("Parent"sv, [&](void) -> bool
+            {
+                return UI::InputString("##parent", transformComponent.parent, ImGuiInputTextFlags_EnterReturnsTrue);
+            });
+
             ImGui::SetCurrentContext(nullptr);
             return changed;
         }
@@ -0,0 +1,221 @@
+#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/API/ComponentMixin.hpp"
+#include "GEK/API/Core.hpp"
+#include "GEK/API/Entity.hpp"
+#include "GEK/API/Editor.hpp"
+#include "GEK/API/Processor.hpp"
+#include "GEK/API/Population.hpp"
+#include "GEK/Components/Transform.hpp"
+#include "GEK/Components/Name.hpp"
+#include <ppl.h>
+
+namespace Gek
+{
+    GEK_CONTEXT_USER(TransformProcessor, Plugin::Core *)
+        , public Plugin::EntityProcessor<TransformProcessor, Components::Transform>
+    {
+    public:
+        struct Data
+        {
+        };
+
+    private:
+        Plugin::Core *core = nullptr;
+        Plugin::Population *population = nullptr;
+        Processor::Name *nameProcessor = nullptr;
+        Edit::Events *events = nullptr;
+
+        // Entities bucketed by hierarchy depth, level zero holds the roots
+        std::vector<std::vector<Plugin::Entity *>> levelList;
+        bool rebuildHierarchy = true;
+
+    public:
+        TransformProcessor(Context *context, Plugin::Core *core)
+            : ContextRegistration(context)
+            , core(core)
+            , population(core->getPopulation())
+        {
+            assert(population);
+
+            core->onInitialized.connect(this, &TransformProcessor::onInitialized);
+            core->onShutdown.connect(this, &TransformProcessor::onShutdown);
+            population->onReset.connect(this, &TransformProcessor::onReset);
+            population->onEntitiesCreated.connect(this, &TransformProcessor::onEntitiesCreated);
+            population->onEntitiesDestroyed.connect(this, &TransformProcessor::onEntitiesDestroyed);
+            population->onComponentsAdded.connect(this, &TransformProcessor::onComponentsAdded);
+            population->onComponentsRemoved.connect(this, &TransformProcessor::onComponentsRemoved);
+            population->onUpdate[75].connect(this, &TransformProcessor::onUpdate);
+        }
+
+        void addEntities(Plugin::Population::EntityBatch const &entityBatch)
+        {
+            EntityProcessor::addEntities(population, entityBatch, [&](bool isNewInsert, auto &data, auto &transformComponent) -> void
+            {
+                rebuildHierarchy = true;
+            });
+        }
+
+        void removeEntities(Plugin::Population::EntityBatch const &entityBatch)
+        {
+            EntityProcessor::removeEntities(entityBatch);
+            rebuildHierarchy = true;
+        }
+
+        Plugin::Entity *getParent(Components::Transform const &transformComponent)
+        {
+            if (transformComponent.parent.empty() || !nameProcessor)
+            {
+                return nullptr;
+            }
+
+            auto parentEntity = nameProcessor->getEntity(transformComponent.parent);
+            if (parentEntity && parentEntity->hasComponent<Components::Transform>())
+            {
+                return parentEntity;
+            }
+
+            return nullptr;
+        }
+
+        void buildHierarchy(void)
+        {
+            levelList.clear();
+
+            const uint32_t maximumDepth = uint32_t(getEntityCount());
+            listEntities([&](Plugin::Entity * const entity, auto &data, auto &transformComponent) -> void
+            {
+                transformComponent.parentEntity = getParent(transformComponent);
+            });
+
+            listEntities([&](Plugin::Entity * const entity, auto &data, auto &transformComponent) -> void
+            {
+                uint32_t depth = 0;
+                for (auto parentEntity = transformComponent.parentEntity; parentEntity; parentEntity = parentEntity->getComponent<Components::Transform>().parentEntity)
+                {
+                    if (++depth > maximumDepth)
+                    {
+                        LockedWrite{ std::cerr } << "Cyclic transform hierarchy found with parent: " << transformComponent.parent;
+                        transformComponent.parentEntity = nullptr;
+                        depth = 0;
+                        break;
+                    }
+                }
+
+                transformComponent.depth = depth;
+                if (levelList.size() <= depth)
+                {
+                    levelList.resize(depth + 1);
+                }
+
+                levelList[depth].push_back(entity);
+            });
+
+            rebuildHierarchy = false;
+        }
+
+        // Plugin::Core
+        void onInitialized(void)
+        {
+            core->listProcessors([&](Plugin::Processor *processor) -> void
+            {
+                auto eventsCheck = dynamic_cast<Edit::Events *>(processor);
+                if (eventsCheck)
+                {
+                    (events = eventsCheck)->onModified.connect(this, &TransformProcessor::onModified);
+                }
+
+                auto nameCheck = dynamic_cast<Processor::Name *>(processor);
+                if (nameCheck)
+                {
+                    nameProcessor = nameCheck;
+                }
+            });
+        }
+
+        void onShutdown(void)
+        {
+            if (events)
+            {
+                events->onModified.disconnect(this, &TransformProcessor::onModified);
+            }
+
+            population->onReset.disconnect(this, &TransformProcessor::onReset);
+            population->onEntitiesCreated.disconnect(this, &TransformProcessor::onEntitiesCreated);
+            population->onEntitiesDestroyed.disconnect(this, &TransformProcessor::onEntitiesDestroyed);
+            population->onComponentsAdded.disconnect(this, &TransformProcessor::onComponentsAdded);
+            population->onComponentsRemoved.disconnect(this, &TransformProcessor::onComponentsRemoved);
+            population->onUpdate[75].disconnect(this, &TransformProcessor::onUpdate);
+            levelList.clear();
+            clear();
+        }
+
+        // Plugin::Editor Slots
+        void onModified(Plugin::Entity * const entity, Hash type)
+        {
+            if (type == Components::Transform::GetIdentifier() || type == Components::Name::GetIdentifier())
+            {
+                rebuildHierarchy = true;
+            }
+        }
+
+        // Plugin::Population Slots
+        void onReset(void)
+        {
+            levelList.clear();
+            clear();
+        }
+
+        void onEntitiesCreated(Plugin::Population::EntityBatch const &entityBatch)
+        {
+            addEntities(entityBatch);
+        }
+
+        void onEntitiesDestroyed(Plugin::Population::EntityBatch const &entityBatch)
+        {
+            removeEntities(entityBatch);
+        }
+
+        void onComponentsAdded(Plugin::Population::EntityBatch const &entityBatch)
+        {
+            addEntities(entityBatch);
+        }
+
+        void onComponentsRemoved(Plugin::Population::EntityBatch const &entityBatch)
+        {
+            removeEntities(entityBatch);
+        }
+
+        void onUpdate(float frameTime)
+        {
+            GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Transform"sv, "Update"sv, Profiler::EmptyArguments)
+            {
+                const bool forceUpdate = rebuildHierarchy;
+                if (rebuildHierarchy)
+                {
+                    buildHierarchy();
+                }
+
+                // Parents are always one level above their children, so each level only depends on
+                // the completed level before it and can be processed in parallel
+                for (auto &level : levelList)
+                {
+                    concurrency::parallel_for_each(std::begin(level), std::end(level), [&](Plugin::Entity * const entity) -> void
+                    {
+                        auto &transformComponent = entity->getComponent<Components::Transform>();
+                        auto localMatrix(transformComponent.getMatrix());
+                        auto parentTransform = (transformComponent.parentEntity ? &transformComponent.parentEntity->getComponent<Components::Transform>() : nullptr);
+                        transformComponent.dirty = (forceUpdate || (parentTransform && parentTransform->dirty) || localMatrix != transformComponent.localMatrix);
+                        if (transformComponent.dirty)
+                        {
+                            transformComponent.localMatrix = localMatrix;
+                            transformComponent.worldMatrix = (parentTransform ? (localMatrix * parentTransform->worldMatrix) : localMatrix);
+                        }
+                    });
+                }
+            } GEK_PROFILER_END_SCOPE();
+        }
+    };
+
+    GEK_REGISTER_CONTEXT_USER(TransformProcessor);
+}; // namespace Gek
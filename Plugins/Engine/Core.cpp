@@ -7,6 +7,7 @@
 #include "GEK/GUI/Dock.hpp"
 #include "GEK/API/Renderer.hpp"
 #include "GEK/API/Processor.hpp"
+#include "GEK/API/Actions.hpp"
 #include "GEK/Engine/Core.hpp"
 #include "GEK/Engine/Resources.hpp"
 #include "GEK/Engine/Population.hpp"
@@ -28,6 +29,10 @@ namespace Gek
             bool engineRunning = false;
 
             JSON configuration;
+
+            // Keyed by system and name, only options that have been resolved to handles are kept
+            std::unordered_map<std::string, std::unique_ptr<OptionState>> optionStateMap;
+
             JSON::Object shadersSettings;
             JSON::Object filtersSettings;
             bool changedVisualOptions = false;
@@ -205,7 +210,9 @@ namespace Gek
 
                 getContext()->stopProfiler();
 
-                configuration.save(getContext()->getCachePath("config.json"s));
+                auto configurationPath(getContext()->getCachePath("config.json"s));
+                configuration.save(configurationPath);
+                getContext()->notifyCacheWrite(configurationPath);
                 CoUninitialize();
             }
 
@@ -342,10 +349,9 @@ namespace Gek
                         auto &shaderNode = shadersNode[shaderName.data()];
                         auto &brdfNode = shaderNode["BRDF"];
                         auto &optionNode = brdfNode[optionName.data()];
-                        auto &selectionNode = optionNode["selection"];
                         auto &optionsArray = optionNode["options"].makeType<JSON::Array>();
 
-                        uint32_t selection = selectionNode.convert(0U);
+                        uint32_t selection = optionNode.getMember("selection"sv).convert(0U);
                         selection = (++selection % optionsArray.size());
 
                         LockedWrite{ std::cout } << shaderName << ": " << optionName << " changed to " << optionsArray[selection].convert(String::Empty);
@@ -408,30 +414,30 @@ namespace Gek
                     {
                     case Window::Key::W:
                     case Window::Key::Up:
-                        population->action(Plugin::Population::Action("move_forward", state));
+                        population->action(Plugin::Population::Action(Actions::MoveForward, state));
                         break;
 
                     case Window::Key::S:
                     case Window::Key::Down:
-                        population->action(Plugin::Population::Action("move_backward", state));
+                        population->action(Plugin::Population::Action(Actions::MoveBackward, state));
                         break;
 
                     case Window::Key::A:
                     case Window::Key::Left:
-                        population->action(Plugin::Population::Action("strafe_left", state));
+                        population->action(Plugin::Population::Action(Actions::StrafeLeft, state));
                         break;
 
                     case Window::Key::D:
                     case Window::Key::Right:
-                        population->action(Plugin::Population::Action("strafe_right", state));
+                        population->action(Plugin::Population::Action(Actions::StrafeRight, state));
                         break;
 
                     case Window::Key::Space:
-                        population->action(Plugin::Population::Action("jump", state));
+                        population->action(Plugin::Population::Action(Actions::Jump, state));
                         break;
 
                     case Window::Key::LeftControl:
-                        population->action(Plugin::Population::Action("crouch", state));
+                        population->action(Plugin::Population::Action(Actions::Crouch, state));
                         break;
                     };
                 }
@@ -482,8 +488,8 @@ namespace Gek
             {
                 if (population)
                 {
-                    population->action(Plugin::Population::Action("turn", xMovement * mouseSensitivity));
-                    population->action(Plugin::Population::Action("tilt", yMovement * mouseSensitivity));
+                    population->action(Plugin::Population::Action(Actions::Turn, xMovement * mouseSensitivity));
+                    population->action(Plugin::Population::Action(Actions::Tilt, yMovement * mouseSensitivity));
                 }
             }
 
@@ -509,6 +515,34 @@ namespace Gek
                             population->save("demo_save");
                         }
 
+                        if (ImGui::MenuItem("Export JSON"))
+                        {
+                            auto savePath(getContext()->getCachePath(FileSystem::CombinePaths("scenes", "demo_save")));
+                            population->convert(savePath.withExtension(".gekpop"), savePath.withExtension(".json"));
+                        }
+
+                        ImGui::Separator();
+                        if (population->isSessionActive())
+                        {
+                            if (ImGui::MenuItem("Stop Session"))
+                            {
+                                population->stopSession();
+                            }
+                        }
+                        else
+                        {
+                            auto sessionPath(getContext()->getCachePath(FileSystem::CombinePaths("sessions", "demo_session.gekrec")));
+                            if (ImGui::MenuItem("Record Session"))
+                            {
+                                population->record(sessionPath);
+                            }
+
+                            if (ImGui::MenuItem("Replay Session", nullptr, false, sessionPath.isFile()))
+                            {
+                                population->replay(sessionPath);
+                            }
+                        }
+
                         ImGui::Separator();
                         if (ImGui::MenuItem("Reset", "CTRL+R"))
                         {
@@ -850,9 +884,16 @@ namespace Gek
                         std::vector<std::string> scenes;
 						getContext()->findDataFiles("scenes"s, [&scenes](FileSystem::Path const &filePath) -> bool
                         {
-                            if (filePath.isFile())
+                            // Paths are relative to the data root and may be inside an archive, so only the name is checked
+                            auto extension(String::GetLower(filePath.getExtension()));
+                            if (extension == ".json" || extension == ".gekpop")
                             {
-                                scenes.push_back(filePath.withoutExtension().getFileName());
+                                // Snapshots share their name with the JSON they were made from
+                                auto sceneName(filePath.withoutExtension().getFileName());
+                                if (std::find(std::begin(scenes), std::end(scenes), sceneName) == std::end(scenes))
+                                {
+                                    scenes.push_back(sceneName);
+                                }
                             }
 
                             return true;
@@ -950,15 +991,45 @@ namespace Gek
             void setOption(std::string_view system, std::string_view name, JSON const &value)
             {
 				configuration[system][name] = value;
+                notifyOption(system, name);
             }
 
             void deleteOption(std::string_view system, std::string_view name)
             {
-                auto &groupNode = configuration.getMember(system).asType(JSON::EmptyObject);
-                auto search = groupNode.find(name.data());
-                if (search != std::end(groupNode))
+                if (configuration.getMember(system).isType<JSON::Object>())
+                {
+                    configuration[system].makeType<JSON::Object>().erase(name);
+                    notifyOption(system, name);
+                }
+            }
+
+            OptionState *getOptionState(std::string_view system, std::string_view name)
+            {
+                auto &optionState = optionStateMap[getOptionKey(system, name)];
+                if (!optionState)
+                {
+                    optionState = std::make_unique<OptionState>();
+                }
+
+                return optionState.get();
+            }
+
+            std::string getOptionKey(std::string_view system, std::string_view name) const
+            {
+                std::string key;
+                key.reserve(system.size() + name.size() + 1);
+                key.append(system);
+                key.push_back('.');
+                key.append(name);
+                return key;
+            }
+
+            void notifyOption(std::string_view system, std::string_view name)
+            {
+                auto optionSearch = optionStateMap.find(getOptionKey(system, name));
+                if (optionSearch != std::end(optionStateMap))
                 {
-                    groupNode.erase(search);
+                    optionSearch->second->onChanged.emit(configuration.getMember(system).getMember(name));
                 }
             }
 
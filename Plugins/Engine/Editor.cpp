@@ -14,6 +14,7 @@
 #include "GEK/API/Processor.hpp"
 #include "GEK/API/Editor.hpp"
 #include "GEK/API/Renderer.hpp"
+#include "GEK/API/Actions.hpp"
 #include "GEK/Engine/Resources.hpp"
 #include "GEK/Engine/Population.hpp"
 #include "GEK/Components/Transform.hpp"
@@ -37,6 +38,7 @@ namespace Gek
             Engine::Resources *resources = nullptr;
             Plugin::Renderer *renderer = nullptr;
             Gek::Processor::Model *modelProcessor = nullptr;
+            Plugin::Option<bool> editorActive;
 
             std::unique_ptr<UI::Dock::WorkSpace> dock;
             std::unique_ptr<UI::Gizmo::WorkSpace> gizmo;
@@ -50,6 +52,8 @@ namespace Gek
             bool strafeLeft = false;
             bool strafeRight = false;
 
+            static constexpr Actions::Identifier ActionList[] = { Actions::MoveForward, Actions::MoveBackward, Actions::StrafeLeft, Actions::StrafeRight, Actions::Turn, Actions::Tilt };
+
             int selectedComponent = 0;
 
             UI::Gizmo::LockAxis currentGizmoAxis = UI::Gizmo::LockAxis::Automatic;
@@ -81,6 +85,7 @@ namespace Gek
                 assert(core);
 
                 core->setOption("editor", "active", false);
+                editorActive.connect(core, "editor"sv, "active"sv, false);
 
                 if (!ImGui::TabWindow::DockPanelIconTextureID)
                 {
@@ -102,7 +107,11 @@ namespace Gek
                 core->onInitialized.connect(this, &Editor::onInitialized);
                 core->onShutdown.connect(this, &Editor::onShutdown);
 				population->onReset.connect(this, &Editor::onReset);
-				population->onAction.connect(this, &Editor::onAction);
+                for (auto identifier : ActionList)
+                {
+                    population->onAction[identifier].connect(this, &Editor::onAction);
+                }
+
                 population->onUpdate[90].connect(this, &Editor::onUpdate);
                 renderer->onShowUserInterface.connect(this, &Editor::onShowUserInterface);
             }
@@ -123,7 +132,11 @@ namespace Gek
             void onShutdown(void)
             {
                 renderer->onShowUserInterface.disconnect(this, &Editor::onShowUserInterface);
-                population->onAction.disconnect(this, &Editor::onAction);
+                for (auto identifier : ActionList)
+                {
+                    population->onAction[identifier].disconnect(this, &Editor::onAction);
+                }
+
                 population->onUpdate[90].disconnect(this, &Editor::onUpdate);
 				population->onReset.disconnect(this, &Editor::onReset);
 			}
@@ -578,7 +591,7 @@ namespace Gek
                     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(5.0f, 10.0f));
                     if (ImGui::BeginMenu("Edit"))
                     {
-                        bool editorEnabled = core->getOption("editor", "active").convert(false);
+                        bool editorEnabled = editorActive.get();
                         if (ImGui::MenuItem("Enable", "CTRL+E", &editorEnabled))
                         {
                             core->setOption("editor", "active", editorEnabled);
@@ -591,8 +604,7 @@ namespace Gek
                     ImGui::EndMainMenuBar();
                 }
 
-                bool editorActive = core->getOption("editor", "active").convert(false);
-                if (!editorActive)
+                if (!editorActive.get())
                 {
                     return;
                 }
@@ -635,49 +647,50 @@ namespace Gek
 
             void onAction(Plugin::Population::Action const &action)
             {
-                bool editorActive = core->getOption("editor", "active").convert(false);
-                if (!editorActive)
+                if (!editorActive.get())
                 {
                     return;
                 }
 
-                if (action.name == "turn")
+                switch (action.identifier)
                 {
+                case Actions::Turn:
                     headingAngle += (action.value * 0.01f);
-                }
-                else if (action.name == "tilt")
-                {
+                    break;
+
+                case Actions::Tilt:
                     lookingAngle += (action.value * 0.01f);
                     lookingAngle = Math::Clamp(lookingAngle, -Math::Pi * 0.5f, Math::Pi * 0.5f);
-                }
-                else if (action.name == "move_forward")
-                {
+                    break;
+
+                case Actions::MoveForward:
                     moveForward = action.state;
-                }
-                else if (action.name == "move_backward")
-                {
+                    break;
+
+                case Actions::MoveBackward:
                     moveBackward = action.state;
-                }
-                else if (action.name == "strafe_left")
-                {
+                    break;
+
+                case Actions::StrafeLeft:
                     strafeLeft = action.state;
-                }
-                else if (action.name == "strafe_right")
-                {
+                    break;
+
+                case Actions::StrafeRight:
                     strafeRight = action.state;
-                }
+                    break;
+                };
             }
 
             void onUpdate(float frameTime)
             {
-                bool editorActive = core->getOption("editor", "active").convert(false);
-                if (editorActive)
+                if (editorActive.get())
                 {
                     Math::Float4x4 viewMatrix(Math::Float4x4::MakePitchRotation(lookingAngle) * Math::Float4x4::MakeYawRotation(headingAngle));
                     position += (viewMatrix.rz.xyz * (((moveForward ? 1.0f : 0.0f) + (moveBackward ? -1.0f : 0.0f)) * 5.0f) * frameTime);
                     position += (viewMatrix.rx.xyz * (((strafeLeft ? -1.0f : 0.0f) + (strafeRight ? 1.0f : 0.0f)) * 5.0f) * frameTime);
                     viewMatrix.translation.xyz = position;
                     viewMatrix.invert();
+                    population->addStreamingViewer(position);
 
                     renderer->queueCamera(viewMatrix, Math::DegreesToRadians(90.0f), (cameraSize.x / cameraSize.y), 0.1f, 200.0f, "Editor Camera"s, cameraTarget, "editor");
                 }
@@ -90,9 +90,13 @@ namespace Gek
                 renderState = resources->createRenderState(Video::RenderState::Description());
 
                 JSON rootNode;
-                rootNode.load(getContext()->findDataPath(FileSystem::CombinePaths("filters", filterName).withExtension(".json")));
+                Archive::Data rootData;
+                if (getContext()->loadDataFile(FileSystem::CombinePaths("filters", filterName).withExtension(".json"), rootData))
+                {
+                    rootNode.parse(rootData.getString(), filterName);
+                }
 
-                ShuntingYard shuntingYard(population->getShuntingYard());
+                ShuntingYard shuntingYard;
                 const auto &coreOptionsNode = core->getOption("filters", filterName);
                 for (auto &coreValuePair : coreOptionsNode.asType(JSON::EmptyObject))
                 {
@@ -100,7 +104,7 @@ namespace Gek
                 }
 
                 auto rootOptionsNode = rootNode.getMember("options"sv);
-                auto &rootOptionsObject = rootOptionsNode.asType(JSON::EmptyObject);
+                auto &rootOptionsObject = rootOptionsNode.makeType<JSON::Object>();
                 for (auto &coreValuePair : coreOptionsNode.asType(JSON::EmptyObject))
                 {
                     rootOptionsObject[coreValuePair.first] = coreValuePair.second;
@@ -109,10 +113,19 @@ namespace Gek
                 auto importSearch = rootOptionsObject.find("#import");
                 if (importSearch != std::end(rootOptionsObject))
                 {
+                    // Imports add members, so take the import list out before they move
+                    auto importNode(std::move(importSearch->second));
+                    rootOptionsObject.erase(importSearch);
+
                     auto importExternal = [&](std::string_view importName) -> void
                     {
                         JSON importOptions;
-                        importOptions.load(getContext()->findDataPath(FileSystem::CombinePaths("shaders", importName).withExtension(".json")));
+                        Archive::Data importOptionsData;
+                        if (getContext()->loadDataFile(FileSystem::CombinePaths("shaders", importName).withExtension(".json"), importOptionsData))
+                        {
+                            importOptions.parse(importOptionsData.getString(), importName);
+                        }
+
                         for (auto &importPair : importOptions.asType(JSON::EmptyObject))
                         {
                             if (rootOptionsObject.count(importPair.first) == 0)
@@ -122,7 +135,7 @@ namespace Gek
                         }
                     };
 
-                    importSearch->second.visit(
+                    importNode.visit(
                         [&](std::string const &importName)
                     {
                         importExternal(importName);
@@ -137,8 +150,6 @@ namespace Gek
                         [&](auto const &)
                     {
                     });
-
-                    rootOptionsObject.erase(importSearch);
                 }
 
                 for (auto &requiredNode : rootNode.getMember("requires"sv).asType(JSON::EmptyArray))
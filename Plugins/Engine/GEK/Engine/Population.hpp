@@ -20,6 +20,19 @@ namespace Gek
             virtual void reset(void) = 0;
 
             virtual void update(float frameTime) = 0;
+
+            // Converts between JSON and binary snapshot (.gekpop) populations, based on each path's extension
+            virtual void convert(FileSystem::Path const &sourcePath, FileSystem::Path const &targetPath) = 0;
+
+            // Reloads the current population with a fixed seed and records the action stream, frame times and random seeds
+            virtual void record(FileSystem::Path const &filePath) = 0;
+
+            // Reloads a recorded population and feeds the recording back frame by frame, live actions are ignored
+            virtual void replay(FileSystem::Path const &filePath) = 0;
+
+            // Writes an active recording to disk, or ends a replay early
+            virtual void stopSession(void) = 0;
+            virtual bool isSessionActive(void) const = 0;
         };
     }; // namespace Plugin
 }; // namespace Gek
\ No newline at end of file
@@ -29,6 +29,10 @@ namespace Gek
             virtual void clear(void) = 0;
             virtual void reload(void) = 0;
 
+            // Called by the renderer between frames, swaps in resources rebuilt by hot reload and releases those they
+            // replaced the frame before
+            virtual void swapReloadedResources(void) = 0;
+
             virtual ShaderHandle getMaterialShader(MaterialHandle material) const = 0;
             virtual ResourceHandle getResourceHandle(std::string_view resourceName) const = 0;
 
@@ -33,7 +33,12 @@ namespace Gek
                 assert(resources);
 
                 JSON materialNode;
-                materialNode.load(getContext()->findDataPath(FileSystem::CombinePaths("materials", materialName).withExtension(".json")));
+                Archive::Data materialData;
+                if (getContext()->loadDataFile(FileSystem::CombinePaths("materials", materialName).withExtension(".json"), materialData))
+                {
+                    materialNode.parse(materialData.getString(), materialName);
+                }
+
                 auto &shaderNode = materialNode.getMember("shader"sv);
                 auto shaderName = shaderNode.getMember("default"sv).convert(String::Empty);
                 ShaderHandle shaderHandle = resources->getShader(shaderName, materialHandle);
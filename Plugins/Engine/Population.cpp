@@ -4,14 +4,27 @@
 #include "GEK/Utility/JSON.hpp"
 #include "GEK/Utility/ContextUser.hpp"
 #include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Allocator.hpp"
+#include "GEK/Utility/Binary.hpp"
 #include "GEK/API/Processor.hpp"
 #include "GEK/API/Entity.hpp"
 #include "GEK/API/Component.hpp"
 #include "GEK/API/Editor.hpp"
+#include "GEK/API/Actions.hpp"
 #include "GEK/Engine/Core.hpp"
 #include "GEK/Engine/Population.hpp"
+#include <concurrent_vector.h>
+#include <concurrent_unordered_map.h>
 #include <concurrent_queue.h>
 #include <ppl.h>
+#include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <tuple>
+#include <deque>
+#include <random>
+#include <mutex>
 #include <map>
 
 namespace Gek
@@ -23,19 +36,60 @@ namespace Gek
         {
         private:
             Components components;
+            Plugin::ComponentMask componentMask = 0;
 
         public:
-            void addComponent(Plugin::Component *component, std::unique_ptr<Plugin::Component::Data> &&data)
+            // Set once the creation command has been applied and the registry owns the entity
+            bool registered = false;
+
+            static BlockPool &GetPool(void)
+            {
+                static BlockPool pool(sizeof(Entity), alignof(Entity), 1024);
+                return pool;
+            }
+
+            static void *operator new(std::size_t size)
+            {
+                return (size == sizeof(Entity) ? GetPool().allocate() : ::operator new(size));
+            }
+
+            static void operator delete(void *data, std::size_t size)
+            {
+                if (size == sizeof(Entity))
+                {
+                    GetPool().free(data);
+                }
+                else
+                {
+                    ::operator delete(data);
+                }
+            }
+
+            // Used when the pools are released, the component data is destroyed by its pool instead
+            void releaseComponents(void)
+            {
+                for (auto &component : components)
+                {
+                    component.second.release();
+                }
+
+                components.clear();
+                componentMask = 0;
+            }
+
+            void addComponent(Plugin::Component *component, Plugin::ComponentMask componentBit, std::unique_ptr<Plugin::Component::Data> &&data)
             {
                 components[component->getIdentifier()] = std::move(data);
+                componentMask |= componentBit;
             }
 
-            void removeComponent(Hash type)
+            void removeComponent(Hash type, Plugin::ComponentMask componentBit)
             {
                 auto componentSearch = components.find(type);
                 if (componentSearch != std::end(components))
                 {
                     components.erase(componentSearch);
+                    componentMask &= ~componentBit;
                 }
             }
 
@@ -59,6 +113,11 @@ namespace Gek
                 return (components.count(type) > 0);
             }
 
+            Plugin::ComponentMask getComponentMask(void) const
+            {
+                return componentMask;
+            }
+
 			Plugin::Component::Data *getComponent(Hash type)
 			{
 				auto componentSearch = components.find(type);
@@ -82,6 +141,144 @@ namespace Gek
 			}
 		};
 
+        struct EntityCommand
+        {
+            enum class Type : uint8_t
+            {
+                CreateEntity = 0,
+                KillEntity,
+                AddComponent,
+                RemoveComponent,
+            };
+
+            // Commands from different producers never interleave, loads apply before streaming and
+            // streaming before runtime changes made through the public interface
+            enum class Producer : uint8_t
+            {
+                Loader = 0,
+                Partition,
+                Runtime,
+            };
+
+            Type type = Type::CreateEntity;
+            Producer producer = Producer::Runtime;
+            uint64_t sortKey = 0;
+
+            // Global issue order, only used to break ties between commands with the same producer and key
+            uint64_t sequence = 0;
+            Entity *entity = nullptr;
+            Hash componentType = 0;
+
+            // Owned by the command until it is applied or discarded
+            Plugin::Component::Data *componentData = nullptr;
+        };
+
+        // A definition resolved once, components that evaluate expressions like random() are loaded for every instance
+        // Counted templates load their deterministic components once and copy them per instance, single entities
+        // load them directly so they don't pay for a copy
+        struct EntityPrototype
+        {
+            struct ComponentPrototype
+            {
+                Plugin::Component *component = nullptr;
+                Plugin::ComponentMask componentBit = 0;
+                JSON const *definition = nullptr;
+                bool deterministic = false;
+
+                // Only loaded for shared prototypes
+                std::unique_ptr<Plugin::Component::Data> data;
+            };
+
+            std::vector<ComponentPrototype> componentList;
+            bool shared = false;
+        };
+
+        // A single entity stamped out of a prototype during a population load
+        struct EntityInstance
+        {
+            EntityPrototype const *prototype = nullptr;
+
+            // Data for the prototype's non-deterministic components, in prototype order
+            std::vector<std::unique_ptr<Plugin::Component::Data>> componentList;
+        };
+
+        // Definitions read from a streamed population that have not been constructed yet
+        // Prototypes point in to their definitions and instances in to their prototypes, so both are kept in deques
+        struct DefinitionBatch
+        {
+            std::deque<Plugin::Population::EntityDefinition> entityDefinitionList;
+            std::deque<EntityPrototype> entityPrototypeList;
+            std::vector<EntityInstance> entityInstanceList;
+
+            // Copy of the reading context when construction starts, each construction thread works from its own copy
+            ShuntingYard shuntingYard;
+        };
+
+        // Component loads on worker threads evaluate expressions with the context set here instead of the population's
+        inline ShuntingYard *&GetThreadShuntingYard(void)
+        {
+            thread_local ShuntingYard *shuntingYard = nullptr;
+            return shuntingYard;
+        }
+
+        struct ShuntingYardScope
+        {
+            ShuntingYard *previous = nullptr;
+
+            ShuntingYardScope(ShuntingYard &shuntingYard)
+                : previous(GetThreadShuntingYard())
+            {
+                GetThreadShuntingYard() = &shuntingYard;
+            }
+
+            ~ShuntingYardScope(void)
+            {
+                GetThreadShuntingYard() = previous;
+            }
+        };
+
+        // A spatial cell of a partitioned population, streamed in and out around the viewers
+        struct PartitionCell
+        {
+            enum class State : uint8_t
+            {
+                Unloaded = 0,
+                Loading,
+                Loaded,
+            };
+
+            Math::Float3 minimum;
+            Math::Float3 maximum;
+            std::string populationName;
+            State state = State::Unloaded;
+            float distance = 0.0f;
+
+            // Constructed entities waiting on the per frame create budget
+            std::vector<Entity *> pendingList;
+            size_t residentCount = 0;
+        };
+
+        struct PartitionLoad
+        {
+            uint32_t generation = 0;
+            size_t cellIndex = 0;
+            std::vector<Entity *> entityList;
+        };
+
+        // One update of a recorded session, the seed is applied to the expression evaluator before the frame runs
+        struct SessionFrame
+        {
+            float frameTime = 0.0f;
+            uint32_t seed = 0;
+            std::vector<Plugin::Population::Action> actionList;
+        };
+
+        struct EntityCommandBuffer
+        {
+            std::mutex mutex;
+            std::vector<EntityCommand> commandList;
+        };
+
         GEK_CONTEXT_USER(Population, Engine::Core *)
             , public Engine::Population
         {
@@ -91,16 +288,66 @@ namespace Gek
             ShuntingYard shuntingYard;
             concurrency::concurrent_queue<Action> actionQueue;
 
+            // Map nodes keep the names stable for the views handed out by getActionName
+            mutable std::mutex actionMutex;
+            std::unordered_map<ActionIdentifier, std::string> actionNameMap;
+
             std::unordered_map<std::string, Hash> componentTypeNameMap;
             std::unordered_map<Hash, std::string> componentNameTypeMap;
             AvailableComponents availableComponents;
 
+            // The last bit is never assigned, so a mask containing an unknown type never matches an entity
+            static constexpr Plugin::ComponentMask UnknownComponentBit = (Plugin::ComponentMask(1) << 63);
+            std::unordered_map<Hash, Plugin::ComponentMask> componentMaskMap;
+
             ThreadPool<1> workerPool;
-            concurrency::concurrent_queue<std::function<void(void)>> entityQueue;
+            concurrency::concurrent_unordered_map<std::thread::id, std::shared_ptr<EntityCommandBuffer>> entityCommandBufferMap;
+            std::atomic<uint64_t> entityCommandSequence = 0;
+            std::vector<EntityCommand> entityCommandList;
             Registry registry;
 
             uint32_t uniqueEntityIdentifier = 0;
 
+            // World partition, cell data is owned by the update thread once a load has published it
+            static constexpr size_t PartitionDestroyPending = std::numeric_limits<size_t>::max();
+            std::mutex partitionMutex;
+            std::vector<PartitionCell> partitionCellList;
+            JSON partitionDefinition;
+            JSON partitionTemplates;
+            float partitionCellSize = 256.0f;
+            float partitionLoadDistance = 384.0f;
+            float partitionUnloadDistance = 512.0f;
+            uint32_t partitionCreateBudget = 256;
+            uint32_t partitionDestroyBudget = 512;
+            uint32_t partitionGeneration = 0;
+            uint64_t partitionSortKey = 0;
+            std::unordered_map<Entity *, size_t> partitionEntityMap;
+            std::vector<Entity *> partitionDestroyList;
+            concurrency::concurrent_queue<PartitionLoad> partitionLoadQueue;
+            concurrency::concurrent_vector<Math::Float3> streamingViewerList;
+            std::vector<Math::Float3> viewerList;
+
+            // Session recording and replay, both start on the first update after the session's population is published
+            enum class SessionMode : uint8_t
+            {
+                None = 0,
+                Recording,
+                Replaying,
+            };
+
+            static constexpr uint32_t SessionMagic = 0x52454B47; // GEKR
+            static constexpr uint32_t SessionVersion = 1;
+            SessionMode sessionMode = SessionMode::None;
+            bool sessionPublished = false;
+            bool sessionStarted = false;
+            FileSystem::Path sessionPath;
+            std::string sessionPopulationName;
+            uint32_t sessionLoadSeed = 0;
+            std::mt19937 sessionRandom;
+            std::vector<SessionFrame> sessionFrameList;
+            size_t sessionFrameIndex = 0;
+            std::string currentPopulationName;
+
         public:
             Population(Context *context, Engine::Core *core)
                 : ContextRegistration(context)
@@ -108,6 +355,11 @@ namespace Gek
             {
                 assert(core);
 
+                for (auto const &actionName : Actions::NameList)
+                {
+                    getActionIdentifier(actionName);
+                }
+
                 LockedWrite{ std::cout } << "Loading component plugins";
                 getContext()->listTypes("ComponentType", [&](std::string_view className) -> void
                 {
@@ -130,309 +382,1677 @@ namespace Gek
                     availableComponents[component->getIdentifier()] = std::move(component);
                 });
 
+                for (auto const &componentPair : availableComponents)
+                {
+                    auto componentIndex = componentMaskMap.size();
+                    if (componentIndex >= 63)
+                    {
+                        LockedWrite{ std::cerr } << "Too many component types for entity masks, ignoring: " << componentPair.second->getName();
+                        continue;
+                    }
+
+                    componentMaskMap[componentPair.first] = (Plugin::ComponentMask(1) << componentIndex);
+                }
+
                 core->onShutdown.connect(this, &Population::onShutdown);
             }
 
             ~Population(void)
             {
                 workerPool.drain();
+                discardEntityCommands();
+                discardPartition();
                 componentTypeNameMap.clear();
                 availableComponents.clear();
             }
 
-            void queueEntity(Plugin::Entity *entity)
+            EntityCommandBuffer &getEntityCommandBuffer(void)
             {
-                entityQueue.push([this, entity](void) -> void
+                auto threadIdentifier = std::this_thread::get_id();
+                auto bufferSearch = entityCommandBufferMap.find(threadIdentifier);
+                if (bufferSearch != std::end(entityCommandBufferMap))
                 {
-                    registry.push_back(Plugin::EntityPtr(entity));
-                    onEntityCreated(entity);
-                });
-            }
+                    return *bufferSearch->second;
+                }
 
-            // Core
-            void onShutdown(void)
-            {
-                workerPool.reset();
-                registry.clear();
+                return *entityCommandBufferMap.insert(std::make_pair(threadIdentifier, std::make_shared<EntityCommandBuffer>())).first->second;
             }
 
-            // Edit::Population
-            AvailableComponents &getAvailableComponents(void)
+            void pushEntityCommand(EntityCommand::Type type, EntityCommand::Producer producer, uint64_t sortKey, Entity *entity, Hash componentType = 0, Plugin::Component::Data *componentData = nullptr)
             {
-                return availableComponents;
-            }
+                auto &commandBuffer = getEntityCommandBuffer();
+                std::lock_guard<std::mutex> lock(commandBuffer.mutex);
 
-            Registry &getRegistry(void)
-            {
-                return registry;
+                EntityCommand command;
+                command.type = type;
+                command.producer = producer;
+                command.sortKey = sortKey;
+                command.sequence = entityCommandSequence++;
+                command.entity = entity;
+                command.componentType = componentType;
+                command.componentData = componentData;
+                commandBuffer.commandList.push_back(command);
             }
 
-            Edit::Component *getComponent(Hash type)
+            void collectEntityCommands(void)
             {
-                auto componentsSearch = availableComponents.find(type);
-                if (componentsSearch != std::end(availableComponents))
+                entityCommandList.clear();
+                for (auto &bufferPair : entityCommandBufferMap)
                 {
-                    return dynamic_cast<Edit::Component *>(componentsSearch->second.get());
+                    auto &commandBuffer = *bufferPair.second;
+                    std::lock_guard<std::mutex> lock(commandBuffer.mutex);
+                    entityCommandList.insert(std::end(entityCommandList), std::begin(commandBuffer.commandList), std::end(commandBuffer.commandList));
+                    commandBuffer.commandList.clear();
                 }
-                
-                return nullptr;
-            }
-
-            // Plugin::Population
-            ShuntingYard &getShuntingYard(void)
-            {
-                return shuntingYard;
             }
 
-            void update(float frameTime)
+            void discardEntityCommand(EntityCommand const &command)
             {
-				GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Population"sv, "Update"sv, Profiler::EmptyArguments)
-				{
-					if (frameTime == 0.0f)
-					{
-						actionQueue.clear();
-					}
-					else
-					{
-						Action action;
-						while (actionQueue.try_pop(action))
-						{
-							onAction(action);
-						};
-					}
-
-					for (auto &slot : onUpdate)
-					{
-						slot.second(frameTime);
-					}
-
-					std::function<void(void)> entityAction;
-					while (entityQueue.try_pop(entityAction))
-					{
-						entityAction();
-					};
-				} GEK_PROFILER_END_SCOPE();
-            }
+                switch (command.type)
+                {
+                case EntityCommand::Type::CreateEntity:
+                    delete command.entity;
+                    break;
 
-            void action(Action const &action)
-            {
-                actionQueue.push(action);
+                case EntityCommand::Type::AddComponent:
+                    delete command.componentData;
+                    break;
+                };
             }
 
-            void reset(void)
+            void discardEntityCommands(void)
             {
-                workerPool.enqueueAndDetach([this](void) -> void
+                collectEntityCommands();
+                for (auto const &command : entityCommandList)
                 {
-                    actionQueue.clear();
-                    onReset();
-                    registry.clear();
-                }, __FILE__, __LINE__);
+                    discardEntityCommand(command);
+                }
+
+                entityCommandList.clear();
             }
 
-            void load(std::string const &populationName)
+            void applyEntityCommands(void)
             {
-                reset();
-                workerPool.enqueueAndDetach([this, populationName](void) -> void
+                // The buffers are gathered in whatever order the map holds them, the sort alone decides the
+                // apply order and the sequence is unique, so the result doesn't depend on the issuing threads
+                collectEntityCommands();
+                std::sort(std::begin(entityCommandList), std::end(entityCommandList), [](EntityCommand const &left, EntityCommand const &right) -> bool
                 {
-                    LockedWrite{ std::cout } << "Loading population: " << populationName;
+                    return (std::tie(left.producer, left.sortKey, left.sequence) < std::tie(right.producer, right.sortKey, right.sequence));
+                });
 
-                    JSON worldNode;
-                    worldNode.load(getContext()->findDataPath(FileSystem::CombinePaths("scenes", populationName).withExtension(".json")));
-                    shuntingYard.setRandomSeed(worldNode.getMember("Seed"sv).convert(uint32_t(std::time(nullptr) & 0xFFFFFFFF)));
-
-                    auto templatesNode = worldNode.getMember("Templates"sv);
-                    auto &populationNode = worldNode.getMember("Population"sv);
-                    auto &populationArray = populationNode.asType(JSON::EmptyArray);
-                    LockedWrite{ std::cout } << "Found " << populationArray.size() << " Entity Definitions";
-                    for (auto const &entityNode : populationArray)
-                    {
-                        uint32_t count = 1;
-                        EntityDefinition entityDefinition;
-                        auto &entityObject = entityNode.asType(JSON::EmptyObject);
-                        auto templateSearch = entityObject.find("Template");
-                        if (templateSearch != std::end(entityObject))
-                        {
-                            std::string templateName;
-                            auto &entityTemplateNode = entityNode.getMember("Template"sv);
-                            auto &entityTemplateObject = entityTemplateNode.asType(JSON::EmptyObject);
-                            if (entityTemplateNode.isType<std::string>())
-                            {
-                                templateName = entityTemplateNode.convert(String::Empty);
-                            }
-                            else
-                            {
-                                if (entityTemplateObject.count("Base"))
-                                {
-                                    templateName = entityTemplateNode.getMember("Base"sv).convert(String::Empty);
-                                }
+                // Consecutive commands of the same type are sent as one batch, the batch is flushed whenever the
+                // type changes so observers still see every change in command order
+                std::unordered_set<Entity *> killedEntitySet;
+                std::vector<std::pair<Entity *, Hash>> removedComponentList;
+                Plugin::Population::EntityBatch entityBatch;
+                auto batchType = EntityCommand::Type::CreateEntity;
+                auto flushEntityBatch = [&](void) -> void
+                {
+                    if (entityBatch.empty())
+                    {
+                        return;
+                    }
 
-                                if (entityTemplateObject.count("Count"))
-                                {
-                                    count = entityTemplateNode.getMember("Count"sv).convert(0);
-                                }
-                            }
+                    switch (batchType)
+                    {
+                    case EntityCommand::Type::CreateEntity:
+                        onEntitiesCreated(entityBatch);
+                        break;
 
-                            auto &templateNode = templatesNode.getMember(templateName);
-                            for (auto const &componentPair : templateNode.asType(JSON::EmptyObject))
+                    case EntityCommand::Type::KillEntity:
+                        onEntitiesDestroyed(entityBatch);
+                        if (true)
+                        {
+                            std::unordered_set<Plugin::Entity *> destroyedEntitySet(std::begin(entityBatch), std::end(entityBatch));
+                            registry.remove_if([&](auto const &entity) -> bool
                             {
-                                entityDefinition[componentPair.first] = componentPair.second;
-                            }
+                                return (destroyedEntitySet.count(entity.get()) > 0);
+                            });
 
-                            entityObject.erase(templateSearch);
+                            break;
                         }
 
-                        for (auto const &componentPair : entityObject)
+                    case EntityCommand::Type::AddComponent:
+                        onComponentsAdded(entityBatch);
+                        break;
+
+                    case EntityCommand::Type::RemoveComponent:
+                        onComponentsRemoved(entityBatch);
+                        for (auto const &removedComponent : removedComponentList)
                         {
-                            auto &componentDefiniti9on = entityDefinition[componentPair.first];
-                            componentPair.second.visit(
-                                [&](JSON::Object const &componentObject)
-                            {
-                                for (auto const &attributePair : componentObject)
-                                {
-                                    componentDefiniti9on[attributePair.first] = attributePair.second;
-                                }
-                            },
-                                [&](auto const &visitedData)
-                            {
-                                componentDefiniti9on = visitedData;
-                            });
+                            removedComponent.first->removeComponent(removedComponent.second, getComponentMask(removedComponent.second));
                         }
 
-                        while (count-- > 0)
-                        {
-                            auto populationEntity = new Entity();
-                            for (auto const &componentDefiniti9on : entityDefinition)
-                            {
-                                addComponent(populationEntity, componentDefiniti9on);
-                            }
+                        removedComponentList.clear();
+                        break;
+                    };
 
-                            auto entity = dynamic_cast<Plugin::Entity *>(populationEntity);
-                            queueEntity(entity);
-                        };
-                    }
-                }, __FILE__, __LINE__);
-            }
+                    entityBatch.clear();
+                };
 
-            void save(std::string const &populationName)
-            {
-                auto population = JSON::Array();
-                for (auto const &entity : registry)
+                for (auto const &command : entityCommandList)
                 {
-                    JSON entityDefinition = JSON::EmptyObject;
-                    Entity *editorEntity = static_cast<Entity *>(entity.get());
-                    editorEntity->listComponents([&](Hash type, Plugin::Component::Data const *data) -> void
+                    if (killedEntitySet.count(command.entity) > 0)
+                    {
+                        discardEntityCommand(command);
+                        continue;
+                    }
+
+                    if (command.type != batchType)
+                    {
+                        flushEntityBatch();
+                        batchType = command.type;
+                    }
+
+                    switch (command.type)
                     {
-                        auto componentName = componentNameTypeMap.find(type);
-                        if (componentName == std::end(componentNameTypeMap))
+                    case EntityCommand::Type::CreateEntity:
+                        registry.push_back(Plugin::EntityPtr(command.entity));
+                        command.entity->registered = true;
+                        onEntityCreated(command.entity);
+                        entityBatch.push_back(command.entity);
+                        break;
+
+                    case EntityCommand::Type::KillEntity:
+                        if (command.entity->registered)
                         {
-                            LockedWrite{ std::cerr } << "Unknown component identifier found when trying to save population: " << type;
+                            onEntityDestroyed(command.entity);
+                            killedEntitySet.insert(command.entity);
+                            releasePartitionEntity(command.entity);
+                            entityBatch.push_back(command.entity);
                         }
-                        else
+
+                        break;
+
+                    case EntityCommand::Type::AddComponent:
+                        if (true)
                         {
-                            auto component = availableComponents.find(type);
-                            if (component == std::end(availableComponents))
+                            std::unique_ptr<Plugin::Component::Data> componentData(command.componentData);
+                            auto componentSearch = availableComponents.find(command.componentType);
+                            if (componentSearch != std::end(availableComponents))
                             {
-								LockedWrite{ std::cerr } << "Unknown component type found when trying to save population: " << componentName->second << ", " << type;
-                            }
-                            else
-                            {
-                                JSON componentDefinition;
-                                component->second->save(data, componentDefinition);
-                                entityDefinition[componentName->second] = componentDefinition;
+                                command.entity->addComponent(componentSearch->second.get(), getComponentMask(command.componentType), std::move(componentData));
+                                onComponentAdded(command.entity);
+                                entityBatch.push_back(command.entity);
                             }
+
+                            break;
                         }
-                    });
 
-                    population.push_back(entityDefinition);
+                    case EntityCommand::Type::RemoveComponent:
+                        if (command.entity->hasComponent(command.componentType))
+                        {
+                            onComponentRemoved(command.entity);
+                            removedComponentList.push_back(std::make_pair(command.entity, command.componentType));
+                            entityBatch.push_back(command.entity);
+                        }
+
+                        break;
+                    };
                 }
 
-                JSON scene;
-                scene["Population"] = population;
-                scene["Seed"] = shuntingYard.getRandomSeed();
-                scene.save(getContext()->getCachePath(FileSystem::CombinePaths("scenes", populationName).withExtension(".json")));
+                flushEntityBatch();
+                entityCommandList.clear();
             }
 
-            Plugin::Entity *createEntity(EntityDefinition const &entityDefinition)
+            // Everything the registry owns came from the pools, so instead of deleting entities and components one at a
+            // time the registry lets go of them and each pool destroys what's left in a single walk over its slabs
+            void releasePools(void)
             {
-                auto populationEntity = new Entity();
-                for (auto const &componentDefinition : entityDefinition)
+                for (auto &entity : registry)
                 {
-                    addComponent(populationEntity, componentDefinition);
+                    entity.release();
                 }
 
-                auto entity = dynamic_cast<Plugin::Entity *>(populationEntity);
-                queueEntity(entity);
-                return entity;
+                registry.clear();
+                Entity::GetPool().release([](void *data) -> void
+                {
+                    auto entity = static_cast<Entity *>(data);
+                    entity->releaseComponents();
+                    entity->~Entity();
+                });
+
+                for (auto &componentPair : availableComponents)
+                {
+                    componentPair.second->releasePool();
+                }
             }
 
-            void killEntity(Plugin::Entity * const entity)
+            void reportPoolStatistics(void)
             {
-                entityQueue.push([this, entity](void) -> void
+                for (auto const &componentPair : availableComponents)
                 {
-                    auto entitySearch = std::find_if(std::begin(registry), std::end(registry), [entity](auto const &entitySearch) -> bool
-                    {
-                        return (entitySearch.get() == entity);
-                    });
+                    auto statistics = componentPair.second->getPoolStatistics();
+                    GEK_PROFILER_COUNTER(getProfiler(), 0, 0, "Population"sv, componentPair.second->getName(), (Profiler::Arguments{ { "live"sv, uint32_t(statistics.liveCount) }, { "bytes"sv, uint32_t(statistics.liveBytes) } }));
+                }
 
-                    if (entitySearch != std::end(registry))
-                    {
-                        onEntityDestroyed(entity);
-                        registry.erase(entitySearch);
-                    }
-                });
+                auto statistics = Entity::GetPool().getStatistics();
+                GEK_PROFILER_COUNTER(getProfiler(), 0, 0, "Population"sv, "Entity"sv, (Profiler::Arguments{ { "live"sv, uint32_t(statistics.liveCount) }, { "bytes"sv, uint32_t(statistics.liveBytes) } }));
             }
 
-            bool addComponent(Entity *entity, ComponentDefinition const &definition)
+            void releasePartitionEntity(Entity *entity)
             {
-                assert(entity);
+                auto entitySearch = partitionEntityMap.find(entity);
+                if (entitySearch != std::end(partitionEntityMap))
+                {
+                    if (entitySearch->second < partitionCellList.size())
+                    {
+                        --partitionCellList[entitySearch->second].residentCount;
+                    }
 
-				auto componentNameSearch = std::find_if(std::begin(componentTypeNameMap), std::end(componentTypeNameMap), [&definition](auto const &componentPair) -> bool
-				{
-					return (definition.first == componentPair.first);
-				});
+                    partitionEntityMap.erase(entitySearch);
+                }
+            }
 
-                if (componentNameSearch != std::end(componentTypeNameMap))
+            void discardPartition(void)
+            {
+                std::lock_guard<std::mutex> lock(partitionMutex);
+                for (auto &cell : partitionCellList)
                 {
-                    auto componentSearch = availableComponents.find(componentNameSearch->second);
-                    if (componentSearch != std::end(availableComponents))
+                    for (auto &entity : cell.pendingList)
                     {
-                        Plugin::Component *componentManager = componentSearch->second.get();
-                        auto component(componentManager->create());
-                        componentManager->load(component.get(), definition.second);
-
-                        entity->addComponent(componentManager, std::move(component));
-                        return true;
+                        delete entity;
                     }
-                    else
+                }
+
+                PartitionLoad partitionLoad;
+                while (partitionLoadQueue.try_pop(partitionLoad))
+                {
+                    for (auto &entity : partitionLoad.entityList)
                     {
-                        LockedWrite{ std::cerr } << "Entity contains unknown component identifier: " << definition.first << ", " << componentNameSearch->second;
+                        delete entity;
                     }
-                }
-                else
+                };
+
+                // Resident entities are owned by the registry
+                ++partitionGeneration;
+                partitionCellList.clear();
+                partitionEntityMap.clear();
+                partitionDestroyList.clear();
+                partitionDefinition = JSON::Empty;
+                partitionTemplates = JSON::Empty;
+                streamingViewerList.clear();
+                viewerList.clear();
+            }
+
+            void loadPartition(JSON const &partitionNode, JSON const &templatesNode)
+            {
+                std::lock_guard<std::mutex> lock(partitionMutex);
+                partitionDefinition = partitionNode;
+                partitionTemplates = templatesNode;
+                partitionCellSize = partitionNode.getMember("CellSize"sv).convert(256.0f);
+                partitionLoadDistance = partitionNode.getMember("LoadDistance"sv).convert(partitionCellSize * 1.5f);
+                partitionUnloadDistance = std::max(partitionLoadDistance, partitionNode.getMember("UnloadDistance"sv).convert(partitionCellSize * 2.0f));
+                partitionCreateBudget = std::max(1U, partitionNode.getMember("CreateBudget"sv).convert(256U));
+                partitionDestroyBudget = std::max(1U, partitionNode.getMember("DestroyBudget"sv).convert(512U));
+                for (auto const &cellNode : partitionNode.getMember("Cells"sv).asType(JSON::EmptyArray))
                 {
-                    LockedWrite{ std::cerr } << "Entity contains unknown component: " << definition.first;
+                    auto &cellIndexNode = cellNode.getMember("Cell"sv);
+                    Math::Float3 cellIndex(
+                        cellIndexNode.getIndex(0).convert(0.0f),
+                        cellIndexNode.getIndex(1).convert(0.0f),
+                        cellIndexNode.getIndex(2).convert(0.0f));
+
+                    PartitionCell cell;
+                    cell.minimum = (cellIndex * partitionCellSize);
+                    cell.maximum = (cell.minimum + partitionCellSize);
+                    cell.populationName = cellNode.getMember("Population"sv).convert(String::Empty);
+                    if (cell.populationName.empty())
+                    {
+                        LockedWrite{ std::cerr } << "Partition cell missing population name";
+                        continue;
+                    }
+
+                    partitionCellList.push_back(std::move(cell));
                 }
 
-                return false;
+                LockedWrite{ std::cout } << "Found " << partitionCellList.size() << " Partition Cells";
             }
 
-            void addComponent(Plugin::Entity * const entity, ComponentDefinition const &definition)
+            void requestPartitionCell(size_t cellIndex)
             {
-                if (addComponent(static_cast<Entity *>(entity), definition))
+                auto &cell = partitionCellList[cellIndex];
+                cell.state = PartitionCell::State::Loading;
+                // The cell loads with its own context, copied here while the update thread owns the population's
+                workerPool.enqueueAndDetach([this, cellIndex, generation = partitionGeneration, populationName = cell.populationName, templatesNode = partitionTemplates, populationShuntingYard = shuntingYard](void) -> void
                 {
-                    onComponentAdded(static_cast<Plugin::Entity *>(entity));
-                }
+                    // Cells always load with the same sequence of random values, regardless of the order they stream in
+                    ShuntingYard cellShuntingYard(populationShuntingYard);
+                    ShuntingYardScope shuntingYardScope(cellShuntingYard);
+
+                    PartitionLoad partitionLoad;
+                    partitionLoad.generation = generation;
+                    partitionLoad.cellIndex = cellIndex;
+
+                    JSON worldNode;
+                    partitionLoad.entityList = loadPopulation(findPopulationPath(populationName), worldNode, templatesNode, uint32_t(GetStableHash(populationName) & 0xFFFFFFFF));
+                    partitionLoadQueue.push(std::move(partitionLoad));
+                }, __FILE__, __LINE__);
             }
 
-            void removeComponent(Plugin::Entity * const entity, Hash type)
+            void unloadPartitionCell(size_t cellIndex)
             {
-                assert(entity);
+                auto &cell = partitionCellList[cellIndex];
+                for (auto &entity : cell.pendingList)
+                {
+                    delete entity;
+                }
 
-                if (entity->hasComponent(type))
+                cell.pendingList.clear();
+                for (auto &entityPair : partitionEntityMap)
                 {
-                    onComponentRemoved(entity);
-                    static_cast<Entity *>(entity)->removeComponent(type);
+                    if (entityPair.second == cellIndex)
+                    {
+                        entityPair.second = PartitionDestroyPending;
+                        partitionDestroyList.push_back(entityPair.first);
+                    }
                 }
+
+                cell.residentCount = 0;
+                cell.state = PartitionCell::State::Unloaded;
+            }
+
+            void updatePartition(void)
+            {
+                if (!streamingViewerList.empty())
+                {
+                    viewerList.assign(std::begin(streamingViewerList), std::end(streamingViewerList));
+                    streamingViewerList.clear();
+                }
+
+                if (partitionCellList.empty())
+                {
+                    return;
+                }
+
+                GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Population"sv, "Partition"sv, Profiler::EmptyArguments)
+                {
+                    PartitionLoad partitionLoad;
+                    while (partitionLoadQueue.try_pop(partitionLoad))
+                    {
+                        if (partitionLoad.generation == partitionGeneration && partitionCellList[partitionLoad.cellIndex].state == PartitionCell::State::Loading)
+                        {
+                            auto &cell = partitionCellList[partitionLoad.cellIndex];
+                            cell.pendingList = std::move(partitionLoad.entityList);
+                            cell.state = PartitionCell::State::Loaded;
+
+                            // Published from the back, so reverse to keep file order
+                            std::reverse(std::begin(cell.pendingList), std::end(cell.pendingList));
+                        }
+                        else
+                        {
+                            for (auto &entity : partitionLoad.entityList)
+                            {
+                                delete entity;
+                            }
+                        }
+                    };
+
+                    // Cells keep their last distances while there are no viewers, so pending work still drains
+                    std::vector<size_t> cellOrderList(partitionCellList.size());
+                    for (size_t cellIndex = 0; cellIndex < partitionCellList.size(); ++cellIndex)
+                    {
+                        auto &cell = partitionCellList[cellIndex];
+                        cell.distance = (viewerList.empty() ? cell.distance : Math::Infinity);
+                        for (auto const &viewer : viewerList)
+                        {
+                            cell.distance = std::min(cell.distance, viewer.getDistance(viewer.getClamped(cell.minimum, cell.maximum)));
+                        }
+
+                        cellOrderList[cellIndex] = cellIndex;
+                    }
+
+                    // Nearest cells load and publish first
+                    std::stable_sort(std::begin(cellOrderList), std::end(cellOrderList), [&](size_t left, size_t right) -> bool
+                    {
+                        return (partitionCellList[left].distance < partitionCellList[right].distance);
+                    });
+
+                    if (!viewerList.empty())
+                    {
+                        for (auto cellIndex : cellOrderList)
+                        {
+                            auto &cell = partitionCellList[cellIndex];
+                            if (cell.state == PartitionCell::State::Unloaded && cell.distance <= partitionLoadDistance)
+                            {
+                                requestPartitionCell(cellIndex);
+                            }
+                            else if (cell.state != PartitionCell::State::Unloaded && cell.distance > partitionUnloadDistance)
+                            {
+                                unloadPartitionCell(cellIndex);
+                            }
+                        }
+                    }
+
+                    uint32_t createCount = 0;
+                    for (auto cellIndex : cellOrderList)
+                    {
+                        auto &cell = partitionCellList[cellIndex];
+                        for (; !cell.pendingList.empty() && createCount < partitionCreateBudget; ++createCount)
+                        {
+                            auto entity = cell.pendingList.back();
+                            cell.pendingList.pop_back();
+                            partitionEntityMap[entity] = cellIndex;
+                            ++cell.residentCount;
+                            queueEntity(entity, EntityCommand::Producer::Partition, partitionSortKey++);
+                        }
+                    }
+
+                    uint32_t destroyCount = 0;
+                    while (!partitionDestroyList.empty() && destroyCount < partitionDestroyBudget)
+                    {
+                        auto entity = partitionDestroyList.back();
+                        partitionDestroyList.pop_back();
+
+                        // Entities killed elsewhere have already been released from the map
+                        auto entitySearch = partitionEntityMap.find(entity);
+                        if (entitySearch != std::end(partitionEntityMap) && entitySearch->second == PartitionDestroyPending)
+                        {
+                            partitionEntityMap.erase(entitySearch);
+                            pushEntityCommand(EntityCommand::Type::KillEntity, EntityCommand::Producer::Partition, partitionSortKey++, entity);
+                            ++destroyCount;
+                        }
+                    };
+
+                    GEK_PROFILER_COUNTER(getProfiler(), 0, 0, "Population"sv, "Partition Streaming"sv, (Profiler::Arguments{ { "created"sv, createCount }, { "destroyed"sv, destroyCount }, { "pending destroy"sv, uint32_t(partitionDestroyList.size()) } }));
+                } GEK_PROFILER_END_SCOPE();
+            }
+
+            void queueEntity(Entity *entity, EntityCommand::Producer producer, uint64_t sortKey)
+            {
+                pushEntityCommand(EntityCommand::Type::CreateEntity, producer, sortKey, entity);
+            }
+
+            // Core
+            void onShutdown(void)
+            {
+                stopSession();
+                workerPool.reset();
+                discardEntityCommands();
+                discardPartition();
+                registry.clear();
+            }
+
+            // Edit::Population
+            AvailableComponents &getAvailableComponents(void)
+            {
+                return availableComponents;
+            }
+
+            Registry &getRegistry(void)
+            {
+                return registry;
+            }
+
+            Edit::Component *getComponent(Hash type)
+            {
+                auto componentsSearch = availableComponents.find(type);
+                if (componentsSearch != std::end(availableComponents))
+                {
+                    return dynamic_cast<Edit::Component *>(componentsSearch->second.get());
+                }
+                
+                return nullptr;
+            }
+
+            // Plugin::Population
+            ShuntingYard &getShuntingYard(void)
+            {
+                auto threadShuntingYard = GetThreadShuntingYard();
+                return (threadShuntingYard ? *threadShuntingYard : shuntingYard);
+            }
+
+            ActionIdentifier getActionIdentifier(std::string_view name)
+            {
+                auto lowerName(String::GetLower(name));
+                auto identifier = Actions::GetIdentifier(lowerName);
+
+                std::lock_guard<std::mutex> lock(actionMutex);
+                auto insertSearch = actionNameMap.insert(std::make_pair(identifier, lowerName));
+                if (!insertSearch.second && insertSearch.first->second != lowerName)
+                {
+                    LockedWrite{ std::cerr } << "Action identifier collision found: " << lowerName << " and " << insertSearch.first->second;
+                }
+
+                return identifier;
+            }
+
+            std::string_view getActionName(ActionIdentifier identifier) const
+            {
+                std::lock_guard<std::mutex> lock(actionMutex);
+                auto nameSearch = actionNameMap.find(identifier);
+                return (nameSearch != std::end(actionNameMap) ? std::string_view(nameSearch->second) : std::string_view());
+            }
+
+            void update(float frameTime)
+            {
+				GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Population"sv, "Update"sv, Profiler::EmptyArguments)
+				{
+					if (sessionMode == SessionMode::Replaying)
+					{
+						frameTime = replaySessionFrame();
+					}
+					else
+					{
+						// The population is published a batch at a time, so a recording holds the simulation until all of it is applied
+						auto sessionFrame = recordSessionFrame(frameTime);
+						if (sessionMode == SessionMode::Recording && !sessionStarted)
+						{
+							frameTime = 0.0f;
+						}
+
+						if (frameTime == 0.0f)
+						{
+							actionQueue.clear();
+						}
+						else
+						{
+							Action action;
+							while (actionQueue.try_pop(action))
+							{
+								sendAction(action);
+								if (sessionFrame)
+								{
+									sessionFrame->actionList.push_back(action);
+								}
+							};
+						}
+					}
+
+					for (auto &slot : onUpdate)
+					{
+						slot.second(frameTime);
+					}
+
+					std::lock_guard<std::mutex> lock(partitionMutex);
+					updatePartition();
+					applyEntityCommands();
+
+					// The session's entities were published under this lock, so they have all been applied by now
+					sessionStarted = (sessionMode != SessionMode::None && sessionPublished);
+				} GEK_PROFILER_END_SCOPE();
+            }
+
+            void action(Action const &action)
+            {
+                actionQueue.push(action);
+            }
+
+            void sendAction(Action const &action)
+            {
+                auto actionSearch = onAction.find(action.identifier);
+                if (actionSearch != std::end(onAction))
+                {
+                    actionSearch->second(action);
+                }
+            }
+
+            void addStreamingViewer(Math::Float3 const &position)
+            {
+                streamingViewerList.push_back(position);
+            }
+
+            void reset(void)
+            {
+                workerPool.enqueueAndDetach([this](void) -> void
+                {
+                    actionQueue.clear();
+                    discardEntityCommands();
+                    discardPartition();
+                    onReset();
+                    releasePools();
+                }, __FILE__, __LINE__);
+            }
+
+            SessionFrame *recordSessionFrame(float frameTime)
+            {
+                if (sessionMode != SessionMode::Recording || !sessionStarted)
+                {
+                    return nullptr;
+                }
+
+                auto &sessionFrame = sessionFrameList.emplace_back();
+                sessionFrame.frameTime = frameTime;
+                sessionFrame.seed = sessionRandom();
+                shuntingYard.setRandomSeed(sessionFrame.seed);
+                return &sessionFrame;
+            }
+
+            // Live actions are dropped while replaying, the simulation is held until the recorded population is applied
+            float replaySessionFrame(void)
+            {
+                actionQueue.clear();
+                if (!sessionStarted)
+                {
+                    return 0.0f;
+                }
+
+                if (sessionFrameIndex >= sessionFrameList.size())
+                {
+                    LockedWrite{ std::cout } << "Session replay finished: " << sessionFrameList.size() << " frames";
+                    stopSession();
+                    return 0.0f;
+                }
+
+                auto const &sessionFrame = sessionFrameList[sessionFrameIndex++];
+                shuntingYard.setRandomSeed(sessionFrame.seed);
+                for (auto const &action : sessionFrame.actionList)
+                {
+                    sendAction(action);
+                }
+
+                return sessionFrame.frameTime;
+            }
+
+            void startSession(SessionMode mode, FileSystem::Path const &filePath)
+            {
+                std::lock_guard<std::mutex> lock(partitionMutex);
+                sessionMode = mode;
+                sessionPath = filePath;
+                sessionPublished = false;
+                sessionStarted = false;
+                sessionFrameIndex = 0;
+                sessionRandom.seed(sessionLoadSeed);
+            }
+
+            //  Header: magic, version, string count, population name, load seed, frame count
+            //  String table: length and characters of each string
+            //  Frames: frame time, seed, action count, then name index and raw value of each action
+            std::vector<uint8_t> saveSession(void)
+            {
+                BinaryStringTable stringTable;
+                std::vector<uint8_t> frameBuffer;
+                BinaryWriter frameWriter(frameBuffer, stringTable);
+                auto populationNameIndex = stringTable.insert(sessionPopulationName);
+                for (auto const &sessionFrame : sessionFrameList)
+                {
+                    frameWriter.write(sessionFrame.frameTime);
+                    frameWriter.write(sessionFrame.seed);
+                    frameWriter.write(uint32_t(sessionFrame.actionList.size()));
+                    for (auto const &action : sessionFrame.actionList)
+                    {
+                        frameWriter.writeString(getActionName(action.identifier));
+                        frameWriter.write(&action.value, sizeof(float));
+                    }
+                }
+
+                auto &stringList = stringTable.getStringList();
+                std::vector<uint8_t> buffer;
+                BinaryWriter writer(buffer, stringTable);
+                writer.write(SessionMagic);
+                writer.write(SessionVersion);
+                writer.write(uint32_t(stringList.size()));
+                writer.write(populationNameIndex);
+                writer.write(sessionLoadSeed);
+                writer.write(uint32_t(sessionFrameList.size()));
+                for (auto const &string : stringList)
+                {
+                    writer.write(uint32_t(string.size()));
+                    writer.write(string.data(), string.size());
+                }
+
+                writer.write(frameBuffer.data(), frameBuffer.size());
+                return buffer;
+            }
+
+            bool loadSession(std::vector<uint8_t> const &buffer)
+            {
+                BinaryReader reader(buffer.data(), buffer.size());
+                if (reader.read<uint32_t>() != SessionMagic || reader.read<uint32_t>() != SessionVersion)
+                {
+                    LockedWrite{ std::cerr } << "Invalid session recording header found";
+                    return false;
+                }
+
+                auto stringCount = reader.read<uint32_t>();
+                auto populationNameIndex = reader.read<uint32_t>();
+                auto loadSeed = reader.read<uint32_t>();
+                auto frameCount = reader.read<uint32_t>();
+                if (!reader.isValid() || (uint64_t(stringCount) * sizeof(uint32_t) + uint64_t(frameCount) * (sizeof(float) + sizeof(uint32_t) * 2)) > reader.getRemaining())
+                {
+                    LockedWrite{ std::cerr } << "Session recording counts exceed file size";
+                    return false;
+                }
+
+                std::vector<std::string_view> stringList;
+                stringList.reserve(stringCount);
+                for (uint32_t index = 0; index < stringCount && reader.isValid(); ++index)
+                {
+                    auto length = reader.read<uint32_t>();
+                    auto string = reinterpret_cast<char const *>(reader.getCurrent());
+                    if (reader.skip(length))
+                    {
+                        stringList.push_back(std::string_view(string, length));
+                    }
+                }
+
+                if (!reader.isValid() || populationNameIndex >= stringList.size())
+                {
+                    LockedWrite{ std::cerr } << "Session recording truncated before frame data";
+                    return false;
+                }
+
+                std::vector<SessionFrame> frameList(frameCount);
+                BinaryReader frameReader(reader.getCurrent(), reader.getRemaining(), &stringList);
+                for (auto &sessionFrame : frameList)
+                {
+                    frameReader.read(sessionFrame.frameTime);
+                    frameReader.read(sessionFrame.seed);
+                    auto actionCount = frameReader.read<uint32_t>();
+                    if (!frameReader.isValid() || uint64_t(actionCount) * sizeof(uint32_t) * 2 > frameReader.getRemaining())
+                    {
+                        break;
+                    }
+
+                    sessionFrame.actionList.resize(actionCount);
+                    for (auto &action : sessionFrame.actionList)
+                    {
+                        action.identifier = getActionIdentifier(frameReader.readString());
+                        frameReader.read(&action.value, sizeof(float));
+                    }
+                }
+
+                if (!frameReader.isValid())
+                {
+                    LockedWrite{ std::cerr } << "Session recording frame data truncated";
+                    return false;
+                }
+
+                sessionPopulationName = stringList[populationNameIndex];
+                sessionLoadSeed = loadSeed;
+                sessionFrameList = std::move(frameList);
+                return true;
+            }
+
+            // Engine::Population
+            void record(FileSystem::Path const &filePath)
+            {
+                if (currentPopulationName.empty())
+                {
+                    LockedWrite{ std::cerr } << "Unable to record session, no population loaded";
+                    return;
+                }
+
+                stopSession();
+                LockedWrite{ std::cout } << "Recording session: " << currentPopulationName << " to " << filePath.getString();
+                sessionPopulationName = currentPopulationName;
+                sessionLoadSeed = uint32_t(std::time(nullptr) & 0xFFFFFFFF);
+                sessionFrameList.clear();
+                startSession(SessionMode::Recording, filePath);
+                loadScene(sessionPopulationName, sessionLoadSeed);
+            }
+
+            void replay(FileSystem::Path const &filePath)
+            {
+                stopSession();
+                static const std::vector<uint8_t> EmptyBuffer;
+                if (!loadSession(FileSystem::Load(filePath, EmptyBuffer)))
+                {
+                    LockedWrite{ std::cerr } << "Unable to load session recording: " << filePath.getString();
+                    return;
+                }
+
+                LockedWrite{ std::cout } << "Replaying session: " << sessionPopulationName << ", " << sessionFrameList.size() << " frames";
+                startSession(SessionMode::Replaying, filePath);
+                loadScene(sessionPopulationName, sessionLoadSeed);
+            }
+
+            void stopSession(void)
+            {
+                if (sessionMode == SessionMode::Recording)
+                {
+                    LockedWrite{ std::cout } << "Saving session recording: " << sessionFrameList.size() << " frames";
+                    FileSystem::Save(sessionPath, saveSession());
+                }
+
+                std::lock_guard<std::mutex> lock(partitionMutex);
+                sessionMode = SessionMode::None;
+                sessionPublished = false;
+                sessionStarted = false;
+                sessionFrameList.clear();
+                sessionFrameIndex = 0;
+            }
+
+            bool isSessionActive(void) const
+            {
+                return (sessionMode != SessionMode::None);
+            }
+
+            using EntityList = std::vector<Entity *>;
+
+            static constexpr uint32_t SnapshotMagic = 0x504B4547; // GEKP
+            static constexpr uint32_t SnapshotVersion = 2;
+
+            // Number of entities constructed together while streaming a population
+            static constexpr size_t StreamBatchSize = 1024;
+
+            // Resolves the definition's template, then loads the components that can differ for each instance
+            // Those share the random sequence, so definitions are added serially in file order
+            // Nothing is added and false is returned if the definition draws random values before the seed is known
+            bool addDefinition(DefinitionBatch &batch, JSON const &entityNode, JSON const &templatesNode, bool seedKnown)
+            {
+                uint32_t count = 1;
+                auto &entityDefinition = batch.entityDefinitionList.emplace_back();
+                auto &entityObject = entityNode.asType(JSON::EmptyObject);
+                if (entityObject.count("Template"sv))
+                {
+                    std::string templateName;
+                    auto &entityTemplateNode = entityNode.getMember("Template"sv);
+                    auto &entityTemplateObject = entityTemplateNode.asType(JSON::EmptyObject);
+                    if (entityTemplateNode.isType<std::string>())
+                    {
+                        templateName = entityTemplateNode.convert(String::Empty);
+                    }
+                    else
+                    {
+                        if (entityTemplateObject.count("Base"))
+                        {
+                            templateName = entityTemplateNode.getMember("Base"sv).convert(String::Empty);
+                        }
+
+                        if (entityTemplateObject.count("Count"))
+                        {
+                            count = entityTemplateNode.getMember("Count"sv).convert(0);
+                        }
+                    }
+
+                    auto &templateNode = templatesNode.getMember(templateName);
+                    for (auto const &componentPair : templateNode.asType(JSON::EmptyObject))
+                    {
+                        entityDefinition[componentPair.first] = componentPair.second;
+                    }
+                }
+
+                for (auto const &componentPair : entityObject)
+                {
+                    if (componentPair.first == "Template"sv)
+                    {
+                        continue;
+                    }
+
+                    auto &componentDefiniti9on = entityDefinition[componentPair.first];
+                    componentPair.second.visit(
+                        [&](JSON::Object const &componentObject)
+                    {
+                        for (auto const &attributePair : componentObject)
+                        {
+                            componentDefiniti9on[attributePair.first] = attributePair.second;
+                        }
+                    },
+                        [&](auto const &visitedData)
+                    {
+                        componentDefiniti9on = visitedData;
+                    });
+                }
+
+                auto compiledPrototype(compilePrototype(entityDefinition));
+                if (!seedKnown && std::any_of(std::begin(compiledPrototype.componentList), std::end(compiledPrototype.componentList), [](auto const &componentPrototype) -> bool
+                {
+                    return !componentPrototype.deterministic;
+                }))
+                {
+                    batch.entityDefinitionList.pop_back();
+                    return false;
+                }
+
+                auto &entityPrototype = batch.entityPrototypeList.emplace_back(std::move(compiledPrototype));
+                entityPrototype.shared = (count > 1);
+                for (uint32_t index = 0; index < count; ++index)
+                {
+                    auto &entityInstance = batch.entityInstanceList.emplace_back();
+                    entityInstance.prototype = &entityPrototype;
+                    entityInstance.componentList = loadNonDeterministicComponents(entityPrototype);
+                }
+
+                return true;
+            }
+
+            // Deterministic components don't draw from the random sequence, so they are loaded here in parallel with
+            // each thread evaluating through its own copy of the batch's context, shared prototypes first
+            EntityList constructBatch(DefinitionBatch &batch)
+            {
+                EntityList entityList(batch.entityInstanceList.size());
+                concurrency::combinable<ShuntingYard> shuntingYardList([&batch](void) -> ShuntingYard
+                {
+                    return batch.shuntingYard;
+                });
+
+                GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Population"sv, "Construct Entities"sv, (Profiler::Arguments{ { "count"sv, uint32_t(entityList.size()) } }))
+                {
+                    concurrency::parallel_for_each(std::begin(batch.entityPrototypeList), std::end(batch.entityPrototypeList), [&](EntityPrototype &entityPrototype) -> void
+                    {
+                        if (entityPrototype.shared)
+                        {
+                            ShuntingYardScope shuntingYardScope(shuntingYardList.local());
+                            loadDeterministicComponents(entityPrototype);
+                        }
+                    });
+
+                    concurrency::parallel_for(size_t(0), batch.entityInstanceList.size(), [&](size_t index) -> void
+                    {
+                        ShuntingYardScope shuntingYardScope(shuntingYardList.local());
+                        auto &entityInstance = batch.entityInstanceList[index];
+                        entityList[index] = instantiatePrototype(*entityInstance.prototype, entityInstance.componentList);
+                    });
+                } GEK_PROFILER_END_SCOPE();
+
+                return entityList;
+            }
+
+            // Entities are created as each element of the population array is read and passed to onEntities a batch at
+            // a time in file order, a batch is constructed in the background while the definitions for the next are read
+            // Only the batches in flight are held in memory, publishing the entities is left to the caller
+            // Seed and Templates may come after the array, saved scenes write them in sorted order, so from the first
+            // element that needs one that hasn't been read yet the elements are held until the rest of the root is read
+            bool streamDefinitions(std::string_view text, FileSystem::Path const &filePath, JSON &worldNode, JSON const &sharedTemplatesNode, uint32_t defaultSeed, std::function<void(EntityList &&)> const &onEntities)
+            {
+                JSON const *templatesNode = &sharedTemplatesNode;
+                bool streamStarted = false;
+                bool seedKnown = false;
+                bool templatesKnown = false;
+                std::vector<JSON> heldEntityList;
+                uint32_t definitionCount = 0;
+                uint32_t constructedCount = 0;
+
+                auto pendingBatch = std::make_unique<DefinitionBatch>();
+                std::unique_ptr<DefinitionBatch> constructingBatch;
+                EntityList constructedList;
+                concurrency::task_group constructionTask;
+                auto finishConstruction = [&](void) -> void
+                {
+                    if (constructingBatch)
+                    {
+                        constructionTask.wait();
+                        constructingBatch.reset();
+                        constructedCount += uint32_t(constructedList.size());
+                        GEK_PROFILER_COUNTER(getProfiler(), 0, 0, "Population"sv, "Load Progress"sv, (Profiler::Arguments{ { "constructed"sv, constructedCount }, { "definitions"sv, definitionCount } }));
+                        onEntities(std::move(constructedList));
+                        constructedList.clear();
+                    }
+                };
+
+                auto startConstruction = [&](void) -> void
+                {
+                    finishConstruction();
+                    constructingBatch = std::move(pendingBatch);
+                    constructingBatch->shuntingYard = getShuntingYard();
+                    pendingBatch = std::make_unique<DefinitionBatch>();
+                    constructionTask.run([this, batch = constructingBatch.get(), &constructedList](void) -> void
+                    {
+                        constructedList = constructBatch(*batch);
+                    });
+                };
+
+                // Called with the root as read so far when the array starts, and with the whole root once the parse ends
+                auto readHeader = [&](JSON const &rootNode, bool complete) -> void
+                {
+                    auto &seedNode = rootNode.getMember("Seed"sv);
+                    if (!seedKnown && (complete || !seedNode.isType<std::nullptr_t>()))
+                    {
+                        getShuntingYard().setRandomSeed(seedNode.convert(defaultSeed));
+                        seedKnown = true;
+                    }
+
+                    auto &worldTemplatesNode = rootNode.getMember("Templates"sv);
+                    if (!templatesKnown && (complete || !worldTemplatesNode.isType<std::nullptr_t>()))
+                    {
+                        if (worldTemplatesNode.isType<JSON::Object>())
+                        {
+                            templatesNode = &worldTemplatesNode;
+                        }
+
+                        templatesKnown = true;
+                    }
+                };
+
+                auto addEntity = [&](JSON const &entityNode) -> bool
+                {
+                    if (!templatesKnown && entityNode.asType(JSON::EmptyObject).count("Template"sv))
+                    {
+                        return false;
+                    }
+
+                    if (!addDefinition(*pendingBatch, entityNode, *templatesNode, seedKnown))
+                    {
+                        return false;
+                    }
+
+                    if (pendingBatch->entityInstanceList.size() >= StreamBatchSize)
+                    {
+                        startConstruction();
+                    }
+
+                    return true;
+                };
+
+                bool loaded = false;
+                GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Population"sv, "Stream Definitions"sv, Profiler::EmptyArguments)
+                {
+                    loaded = worldNode.parse(text, filePath.getString(), "Population"sv, [&](JSON const &rootNode, JSON &&entityNode) -> bool
+                    {
+                        if (!streamStarted)
+                        {
+                            readHeader(rootNode, false);
+                            streamStarted = true;
+                        }
+
+                        ++definitionCount;
+                        if (!heldEntityList.empty() || !addEntity(entityNode))
+                        {
+                            heldEntityList.push_back(std::move(entityNode));
+                        }
+
+                        return true;
+                    });
+
+                    // The root members after the array were kept by the parse, so the held elements can be added now
+                    // Entities read before an error are still constructed, the same as those already handed off
+                    readHeader(worldNode, true);
+                    for (auto const &entityNode : heldEntityList)
+                    {
+                        addEntity(entityNode);
+                    }
+
+                    heldEntityList.clear();
+                    if (!pendingBatch->entityInstanceList.empty())
+                    {
+                        startConstruction();
+                    }
+
+                    finishConstruction();
+                } GEK_PROFILER_END_SCOPE();
+
+                LockedWrite{ std::cout } << "Found " << definitionCount << " Entity Definitions";
+                return loaded;
+            }
+
+            // Snapshot layout, all values are little endian
+            //  Header: magic, version, string count, component type count, entity count, seed
+            //  World: length and JSON text of the scene's Partition and Templates, empty if it has none
+            //  String table: length and characters of each string
+            //  Component types: string index of each component name
+            //  Entity offsets: byte offset of each entity record from the start of the entity data
+            //  Entity data: component count, then type index, byte size and data for each component
+            EntityList loadSnapshot(std::vector<uint8_t> const &buffer, JSON &worldNode)
+            {
+                BinaryReader reader(buffer.data(), buffer.size());
+                if (reader.read<uint32_t>() != SnapshotMagic || reader.read<uint32_t>() != SnapshotVersion)
+                {
+                    LockedWrite{ std::cerr } << "Invalid population snapshot header found";
+                    return EntityList();
+                }
+
+                auto stringCount = reader.read<uint32_t>();
+                auto componentTypeCount = reader.read<uint32_t>();
+                auto entityCount = reader.read<uint32_t>();
+                auto seed = reader.read<uint32_t>();
+                auto worldLength = reader.read<uint32_t>();
+                auto worldText = reinterpret_cast<char const *>(reader.getCurrent());
+                if (!reader.skip(worldLength))
+                {
+                    LockedWrite{ std::cerr } << "Population snapshot truncated in world data";
+                    return EntityList();
+                }
+
+                if (worldLength > 0 && !worldNode.parse(std::string_view(worldText, worldLength), "snapshot"sv))
+                {
+                    LockedWrite{ std::cerr } << "Unable to parse population snapshot world data";
+                    worldNode = JSON::Empty;
+                }
+
+                if (!reader.isValid() || ((uint64_t(stringCount) + componentTypeCount) * sizeof(uint32_t) + uint64_t(entityCount) * sizeof(uint64_t)) > reader.getRemaining())
+                {
+                    LockedWrite{ std::cerr } << "Population snapshot counts exceed file size";
+                    return EntityList();
+                }
+
+                getShuntingYard().setRandomSeed(seed);
+                std::vector<std::string_view> stringList;
+                stringList.reserve(stringCount);
+                for (uint32_t index = 0; index < stringCount && reader.isValid(); ++index)
+                {
+                    auto length = reader.read<uint32_t>();
+                    auto string = reinterpret_cast<char const *>(reader.getCurrent());
+                    if (reader.skip(length))
+                    {
+                        stringList.push_back(std::string_view(string, length));
+                    }
+                }
+
+                BinaryReader tableReader(reader.getCurrent(), reader.getRemaining(), &stringList);
+                std::vector<Plugin::Component *> componentTypeList(componentTypeCount);
+                std::vector<Plugin::ComponentMask> componentBitList(componentTypeCount);
+                for (uint32_t componentTypeIndex = 0; componentTypeIndex < componentTypeCount; ++componentTypeIndex)
+                {
+                    auto componentName = tableReader.readString();
+                    if (tableReader.isValid())
+                    {
+                        auto componentManager = getComponentManager(std::string(componentName));
+                        componentTypeList[componentTypeIndex] = componentManager;
+                        componentBitList[componentTypeIndex] = (componentManager ? getComponentMask(componentManager->getIdentifier()) : 0);
+                    }
+                }
+
+                std::vector<uint64_t> entityOffsetList(entityCount);
+                for (auto &entityOffset : entityOffsetList)
+                {
+                    tableReader.read(entityOffset);
+                }
+
+                if (!reader.isValid() || !tableReader.isValid())
+                {
+                    LockedWrite{ std::cerr } << "Population snapshot truncated before entity data";
+                    return EntityList();
+                }
+
+                auto entityData = tableReader.getCurrent();
+                auto entityDataSize = tableReader.getRemaining();
+
+                // Component data is plain values and string table lookups, so every entity is decoded independently
+                EntityList entityList(entityCount);
+                std::atomic<uint32_t> constructedCount = 0;
+                GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Population"sv, "Decode Entities"sv, (Profiler::Arguments{ { "count"sv, entityCount } }))
+                {
+                    concurrency::parallel_for(size_t(0), entityList.size(), [&](size_t index) -> void
+                    {
+                        auto entityOffset = entityOffsetList[index];
+                        auto populationEntity = new Entity();
+                        entityList[index] = populationEntity;
+                        if (entityOffset >= entityDataSize)
+                        {
+                            LockedWrite{ std::cerr } << "Population snapshot entity offset out of range: " << index;
+                            return;
+                        }
+
+                        BinaryReader entityReader(entityData + entityOffset, size_t(entityDataSize - entityOffset), &stringList);
+                        auto componentCount = entityReader.read<uint32_t>();
+                        for (uint32_t component = 0; component < componentCount && entityReader.isValid(); ++component)
+                        {
+                            auto componentTypeIndex = entityReader.read<uint32_t>();
+                            auto componentSize = entityReader.read<uint32_t>();
+                            auto componentData = entityReader.getCurrent();
+                            if (!entityReader.skip(componentSize))
+                            {
+                                LockedWrite{ std::cerr } << "Population snapshot component data truncated: " << index;
+                                break;
+                            }
+
+                            auto componentManager = (componentTypeIndex < componentTypeList.size() ? componentTypeList[componentTypeIndex] : nullptr);
+                            if (componentManager)
+                            {
+                                BinaryReader componentReader(componentData, componentSize, &stringList);
+                                auto data(componentManager->create());
+                                componentManager->load(data.get(), componentReader);
+                                if (componentReader.isValid())
+                                {
+                                    populationEntity->addComponent(componentManager, componentBitList[componentTypeIndex], std::move(data));
+                                }
+                                else
+                                {
+                                    LockedWrite{ std::cerr } << "Population snapshot component data invalid: " << componentManager->getName();
+                                }
+                            }
+                        }
+
+                        auto constructed = (constructedCount.fetch_add(1) + 1);
+                        if ((constructed % 1024) == 0 || constructed == entityCount)
+                        {
+                            GEK_PROFILER_COUNTER(getProfiler(), 0, 0, "Population"sv, "Load Progress"sv, (Profiler::Arguments{ { "constructed"sv, constructed }, { "total"sv, entityCount } }));
+                        }
+                    });
+                } GEK_PROFILER_END_SCOPE();
+
+                return entityList;
+            }
+
+            template <typename FUNCTION>
+            void listEntityComponents(Entity *entity, FUNCTION &&onComponent)
+            {
+                entity->listComponents([&](Hash type, Plugin::Component::Data const *data) -> void
+                {
+                    auto componentName = componentNameTypeMap.find(type);
+                    if (componentName == std::end(componentNameTypeMap))
+                    {
+                        LockedWrite{ std::cerr } << "Unknown component identifier found when trying to save population: " << type;
+                    }
+                    else
+                    {
+                        auto component = availableComponents.find(type);
+                        if (component == std::end(availableComponents))
+                        {
+							LockedWrite{ std::cerr } << "Unknown component type found when trying to save population: " << componentName->second << ", " << type;
+                        }
+                        else
+                        {
+                            onComponent(componentName->second, component->second.get(), data);
+                        }
+                    }
+                });
+            }
+
+            JSON saveDefinitions(EntityList const &entityList, JSON const &worldNode)
+            {
+                auto population = JSON::Array();
+                for (auto const &entity : entityList)
+                {
+                    JSON entityDefinition = JSON::EmptyObject;
+                    listEntityComponents(entity, [&](std::string const &componentName, Plugin::Component *component, Plugin::Component::Data const *data) -> void
+                    {
+                        JSON componentDefinition;
+                        component->save(data, componentDefinition);
+                        entityDefinition[componentName] = componentDefinition;
+                    });
+
+                    population.push_back(entityDefinition);
+                }
+
+                JSON scene;
+                for (auto const &memberName : { "Partition"sv, "Templates"sv })
+                {
+                    auto &memberNode = worldNode.getMember(memberName);
+                    if (memberNode.isType<JSON::Object>())
+                    {
+                        scene[memberName] = memberNode;
+                    }
+                }
+
+                scene["Population"] = population;
+                scene["Seed"] = getShuntingYard().getRandomSeed();
+                return scene;
+            }
+
+            std::vector<uint8_t> saveSnapshot(EntityList const &entityList, JSON const &worldNode)
+            {
+                BinaryStringTable stringTable;
+                std::unordered_map<Hash, uint32_t> componentTypeIndexMap;
+                std::vector<uint32_t> componentTypeList;
+                std::vector<uint64_t> entityOffsetList;
+                entityOffsetList.reserve(entityList.size());
+
+                std::vector<uint8_t> entityBuffer;
+                BinaryWriter entityWriter(entityBuffer, stringTable);
+                for (auto const &entity : entityList)
+                {
+                    entityOffsetList.push_back(entityWriter.getPosition());
+                    auto componentCountPosition = entityWriter.getPosition();
+                    uint32_t componentCount = 0;
+                    entityWriter.write(componentCount);
+                    listEntityComponents(entity, [&](std::string const &componentName, Plugin::Component *component, Plugin::Component::Data const *data) -> void
+                    {
+                        auto typeSearch = componentTypeIndexMap.insert(std::make_pair(component->getIdentifier(), uint32_t(componentTypeList.size())));
+                        if (typeSearch.second)
+                        {
+                            componentTypeList.push_back(stringTable.insert(componentName));
+                        }
+
+                        entityWriter.write(typeSearch.first->second);
+                        auto componentSizePosition = entityWriter.getPosition();
+                        entityWriter.write(uint32_t(0));
+                        component->save(data, entityWriter);
+                        entityWriter.overwrite(componentSizePosition, uint32_t(entityWriter.getPosition() - componentSizePosition - sizeof(uint32_t)));
+                        ++componentCount;
+                    });
+
+                    entityWriter.overwrite(componentCountPosition, componentCount);
+                }
+
+                auto &stringList = stringTable.getStringList();
+                std::vector<uint8_t> buffer;
+                BinaryWriter writer(buffer, stringTable);
+                writer.write(SnapshotMagic);
+                writer.write(SnapshotVersion);
+                writer.write(uint32_t(stringList.size()));
+                writer.write(uint32_t(componentTypeList.size()));
+                writer.write(uint32_t(entityList.size()));
+                writer.write(getShuntingYard().getRandomSeed());
+
+                JSON worldData;
+                for (auto const &memberName : { "Partition"sv, "Templates"sv })
+                {
+                    auto &memberNode = worldNode.getMember(memberName);
+                    if (memberNode.isType<JSON::Object>())
+                    {
+                        worldData[memberName] = memberNode;
+                    }
+                }
+
+                auto worldText(worldData.isType<JSON::Object>() ? worldData.getString() : std::string());
+                writer.write(uint32_t(worldText.size()));
+                writer.write(worldText.data(), worldText.size());
+                for (auto const &string : stringList)
+                {
+                    writer.write(uint32_t(string.size()));
+                    writer.write(string.data(), string.size());
+                }
+
+                writer.write(componentTypeList.data(), componentTypeList.size() * sizeof(uint32_t));
+                writer.write(entityOffsetList.data(), entityOffsetList.size() * sizeof(uint64_t));
+                writer.write(entityBuffer.data(), entityBuffer.size());
+                return buffer;
+            }
+
+            bool isSnapshot(FileSystem::Path const &filePath)
+            {
+                return (String::GetLower(filePath.getExtension()) == ".gekpop");
+            }
+
+            // The scene's root nodes other than Population are returned in worldNode
+            EntityList loadPopulation(FileSystem::Path const &filePath, JSON &worldNode, JSON const &sharedTemplatesNode = JSON::Empty, uint32_t defaultSeed = uint32_t(std::time(nullptr) & 0xFFFFFFFF))
+            {
+                if (isSnapshot(filePath))
+                {
+                    static const std::vector<uint8_t> EmptyBuffer;
+                    return loadSnapshot(FileSystem::Load(filePath, EmptyBuffer), worldNode);
+                }
+
+                EntityList entityList;
+                streamDefinitions(FileSystem::Load(filePath, String::Empty), filePath, worldNode, sharedTemplatesNode, defaultSeed, [&](EntityList &&batchList) -> void
+                {
+                    entityList.insert(std::end(entityList), std::begin(batchList), std::end(batchList));
+                });
+
+                return entityList;
+            }
+
+            // Only the Partition and Templates nodes of worldNode are kept, so streamed cells are saved as references
+            void savePopulation(EntityList const &entityList, FileSystem::Path const &filePath, JSON const &worldNode)
+            {
+                if (isSnapshot(filePath))
+                {
+                    FileSystem::Save(filePath, saveSnapshot(entityList, worldNode));
+                }
+                else
+                {
+                    saveDefinitions(entityList, worldNode).save(filePath);
+                }
+
+                getContext()->notifyCacheWrite(filePath);
+            }
+
+            FileSystem::Path findPopulationPath(std::string const &populationName)
+            {
+                auto populationPath(FileSystem::CombinePaths("scenes", populationName));
+                auto snapshotPath(getContext()->findDataPath(populationPath.withExtension(".gekpop")));
+                auto definitionPath(getContext()->findDataPath(populationPath.withExtension(".json")));
+
+                // Snapshots are preferred unless the authored JSON has been edited since
+                if (snapshotPath.isFile() && (!definitionPath.isFile() || snapshotPath.isNewerThan(definitionPath)))
+                {
+                    return snapshotPath;
+                }
+
+                return definitionPath;
+            }
+
+            void load(std::string const &populationName)
+            {
+                stopSession();
+                loadScene(populationName, uint32_t(std::time(nullptr) & 0xFFFFFFFF));
+            }
+
+            void loadScene(std::string const &populationName, uint32_t defaultSeed)
+            {
+                reset();
+                currentPopulationName = populationName;
+                workerPool.enqueueAndDetach([this, populationName, defaultSeed](void) -> void
+                {
+                    LockedWrite{ std::cout } << "Loading population: " << populationName;
+
+                    // Publish in file order so the registry matches the serial load
+                    uint64_t entityIndex = 0;
+                    auto publishEntities = [&](EntityList const &entityList) -> void
+                    {
+                        GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Population"sv, "Publish Entities"sv, Profiler::EmptyArguments)
+                        {
+                            std::lock_guard<std::mutex> lock(partitionMutex);
+                            for (auto const &entity : entityList)
+                            {
+                                queueEntity(entity, EntityCommand::Producer::Loader, entityIndex++);
+                            }
+                        } GEK_PROFILER_END_SCOPE();
+                    };
+
+                    JSON worldNode;
+                    auto populationPath(findPopulationPath(populationName));
+                    if (isSnapshot(populationPath))
+                    {
+                        publishEntities(loadPopulation(populationPath, worldNode));
+                    }
+                    else
+                    {
+                        // Entities are published a batch at a time as the scene is read
+                        streamDefinitions(FileSystem::Load(populationPath, String::Empty), populationPath, worldNode, JSON::Empty, defaultSeed, [&](EntityList &&entityList) -> void
+                        {
+                            publishEntities(entityList);
+                        });
+                    }
+
+                    // Partition cells stream in around the viewers once loaded, from either the JSON scene or a snapshot of it
+                    auto &partitionNode = worldNode.getMember("Partition"sv);
+                    if (partitionNode.isType<JSON::Object>())
+                    {
+                        loadPartition(partitionNode, worldNode.getMember("Templates"sv));
+                    }
+
+                    LockedWrite{ std::cout } << "Loaded " << entityIndex << " Entities";
+                    reportPoolStatistics();
+
+                    std::lock_guard<std::mutex> lock(partitionMutex);
+                    sessionPublished = true;
+                }, __FILE__, __LINE__);
+            }
+
+            void save(std::string const &populationName)
+            {
+                // Streamed cell entities are left to their own populations, the partition is saved to load them again
+                EntityList entityList;
+                JSON worldNode;
+                if (true)
+                {
+                    std::lock_guard<std::mutex> lock(partitionMutex);
+                    entityList.reserve(registry.size());
+                    for (auto const &entity : registry)
+                    {
+                        auto populationEntity = static_cast<Entity *>(entity.get());
+                        if (!partitionEntityMap.count(populationEntity))
+                        {
+                            entityList.push_back(populationEntity);
+                        }
+                    }
+
+                    worldNode["Partition"sv] = partitionDefinition;
+                    worldNode["Templates"sv] = partitionTemplates;
+                }
+
+                savePopulation(entityList, getContext()->getCachePath(FileSystem::CombinePaths("scenes", populationName).withExtension(".gekpop")), worldNode);
+            }
+
+            // Engine::Population
+            void convert(FileSystem::Path const &sourcePath, FileSystem::Path const &targetPath)
+            {
+                workerPool.enqueueAndDetach([this, sourcePath, targetPath, populationShuntingYard = shuntingYard](void) -> void
+                {
+                    LockedWrite{ std::cout } << "Converting population: " << sourcePath.getString() << " to " << targetPath.getString();
+
+                    ShuntingYard convertShuntingYard(populationShuntingYard);
+                    ShuntingYardScope shuntingYardScope(convertShuntingYard);
+                    JSON worldNode;
+                    auto entityList(loadPopulation(sourcePath, worldNode));
+                    savePopulation(entityList, targetPath, worldNode);
+                    for (auto &entity : entityList)
+                    {
+                        delete entity;
+                    }
+                }, __FILE__, __LINE__);
+            }
+
+            Plugin::Entity *createEntity(EntityDefinition const &entityDefinition, uint64_t sortKey)
+            {
+                auto populationEntity = new Entity();
+                for (auto const &componentDefinition : entityDefinition)
+                {
+                    addComponent(populationEntity, componentDefinition);
+                }
+
+                queueEntity(populationEntity, EntityCommand::Producer::Runtime, sortKey);
+                return populationEntity;
+            }
+
+            void killEntity(Plugin::Entity * const entity, uint64_t sortKey)
+            {
+                assert(entity);
+
+                pushEntityCommand(EntityCommand::Type::KillEntity, EntityCommand::Producer::Runtime, sortKey, static_cast<Entity *>(entity));
+            }
+
+            Plugin::ComponentMask getComponentMask(Hash type) const
+            {
+                auto maskSearch = componentMaskMap.find(type);
+                return (maskSearch == std::end(componentMaskMap) ? UnknownComponentBit : maskSearch->second);
+            }
+
+            Plugin::Component *getComponentManager(std::string const &componentName)
+            {
+                auto componentNameSearch = componentTypeNameMap.find(componentName);
+                if (componentNameSearch != std::end(componentTypeNameMap))
+                {
+                    auto componentSearch = availableComponents.find(componentNameSearch->second);
+                    if (componentSearch != std::end(availableComponents))
+                    {
+                        return componentSearch->second.get();
+                    }
+                    else
+                    {
+                        LockedWrite{ std::cerr } << "Entity contains unknown component identifier: " << componentName << ", " << componentNameSearch->second;
+                    }
+                }
+                else
+                {
+                    LockedWrite{ std::cerr } << "Entity contains unknown component: " << componentName;
+                }
+
+                return nullptr;
+            }
+
+            std::pair<Plugin::Component *, std::unique_ptr<Plugin::Component::Data>> createComponent(ComponentDefinition const &definition)
+            {
+                Plugin::Component *componentManager = getComponentManager(definition.first);
+                if (componentManager)
+                {
+                    auto component(componentManager->create());
+                    componentManager->load(component.get(), definition.second);
+                    return std::make_pair(componentManager, std::move(component));
+                }
+
+                return std::make_pair(nullptr, nullptr);
+            }
+
+            EntityPrototype compilePrototype(EntityDefinition const &entityDefinition)
+            {
+                EntityPrototype entityPrototype;
+                entityPrototype.componentList.reserve(entityDefinition.size());
+                for (auto const &componentDefinition : entityDefinition)
+                {
+                    Plugin::Component *componentManager = getComponentManager(componentDefinition.first);
+                    if (componentManager)
+                    {
+                        EntityPrototype::ComponentPrototype componentPrototype;
+                        componentPrototype.component = componentManager;
+                        componentPrototype.componentBit = getComponentMask(componentManager->getIdentifier());
+                        componentPrototype.definition = &componentDefinition.second;
+                        componentPrototype.deterministic = componentManager->isDeterministic(componentDefinition.second);
+                        entityPrototype.componentList.push_back(std::move(componentPrototype));
+                    }
+                }
+
+                return entityPrototype;
+            }
+
+            void loadDeterministicComponents(EntityPrototype &entityPrototype)
+            {
+                for (auto &componentPrototype : entityPrototype.componentList)
+                {
+                    if (componentPrototype.deterministic)
+                    {
+                        componentPrototype.data = componentPrototype.component->create();
+                        componentPrototype.component->load(componentPrototype.data.get(), *componentPrototype.definition);
+                    }
+                }
+            }
+
+            std::vector<std::unique_ptr<Plugin::Component::Data>> loadNonDeterministicComponents(EntityPrototype const &entityPrototype)
+            {
+                std::vector<std::unique_ptr<Plugin::Component::Data>> componentList;
+                for (auto const &componentPrototype : entityPrototype.componentList)
+                {
+                    if (!componentPrototype.deterministic)
+                    {
+                        auto component(componentPrototype.component->create());
+                        componentPrototype.component->load(component.get(), *componentPrototype.definition);
+                        componentList.push_back(std::move(component));
+                    }
+                }
+
+                return componentList;
+            }
+
+            Entity *instantiatePrototype(EntityPrototype const &entityPrototype, std::vector<std::unique_ptr<Plugin::Component::Data>> &componentList)
+            {
+                auto populationEntity = new Entity();
+                auto componentSearch = std::begin(componentList);
+                for (auto const &componentPrototype : entityPrototype.componentList)
+                {
+                    if (!componentPrototype.deterministic)
+                    {
+                        populationEntity->addComponent(componentPrototype.component, componentPrototype.componentBit, std::move(*componentSearch++));
+                    }
+                    else if (componentPrototype.data)
+                    {
+                        populationEntity->addComponent(componentPrototype.component, componentPrototype.componentBit, componentPrototype.component->clone(componentPrototype.data.get()));
+                    }
+                    else
+                    {
+                        auto data(componentPrototype.component->create());
+                        componentPrototype.component->load(data.get(), *componentPrototype.definition);
+                        populationEntity->addComponent(componentPrototype.component, componentPrototype.componentBit, std::move(data));
+                    }
+                }
+
+                componentList.clear();
+                return populationEntity;
+            }
+
+            bool addComponent(Entity *entity, ComponentDefinition const &definition)
+            {
+                assert(entity);
+
+                auto component(createComponent(definition));
+                if (component.first)
+                {
+                    entity->addComponent(component.first, getComponentMask(component.first->getIdentifier()), std::move(component.second));
+                    return true;
+                }
+
+                return false;
+            }
+
+            void addComponent(Plugin::Entity * const entity, ComponentDefinition const &definition, uint64_t sortKey)
+            {
+                assert(entity);
+
+                auto component(createComponent(definition));
+                if (component.first)
+                {
+                    pushEntityCommand(EntityCommand::Type::AddComponent, EntityCommand::Producer::Runtime, sortKey, static_cast<Entity *>(entity), component.first->getIdentifier(), component.second.release());
+                }
+            }
+
+            void removeComponent(Plugin::Entity * const entity, Hash type, uint64_t sortKey)
+            {
+                assert(entity);
+
+                pushEntityCommand(EntityCommand::Type::RemoveComponent, EntityCommand::Producer::Runtime, sortKey, static_cast<Entity *>(entity), type);
             }
 
             void listEntities(std::function<void(Plugin::Entity *)> onEntity) const
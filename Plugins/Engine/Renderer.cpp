@@ -26,6 +26,7 @@
 #include <concurrent_vector.h>
 #include <concurrent_queue.h>
 #include <smmintrin.h>
+#include <unordered_set>
 #include <algorithm>
 #include <ppl.h>
 
@@ -180,6 +181,7 @@ namespace Gek
 			{
 				Video::Device *videoDevice = nullptr;
 				std::vector<Plugin::Entity *> entityList;
+				std::unordered_set<Plugin::Entity *> entitySet;
 				concurrency::concurrent_vector<DATA, AlignedAllocator<DATA, 16>> lightList;
 				Video::BufferPtr lightDataBuffer;
 
@@ -193,40 +195,45 @@ namespace Gek
 					createBuffer(RESERVE);
 				}
 
-				void addEntity(Plugin::Entity * const entity)
+				void addEntities(Plugin::Population *population, Plugin::Population::EntityBatch const &entityBatch)
 				{
-					if (entity->hasComponent<COMPONENT>())
+					concurrency::critical_section::scoped_lock lock(addSection);
+					const auto requiredMask = population->getComponentMask<Components::Transform, Components::Color, COMPONENT>();
+					for (auto &entity : entityBatch)
 					{
-						concurrency::critical_section::scoped_lock lock(addSection);
-						auto search = std::find_if(std::begin(entityList), std::end(entityList), [entity](Plugin::Entity * const search) -> bool
-						{
-							return (entity == search);
-						});
-
-						if (search == std::end(entityList))
+						if (entity->hasComponentMask(requiredMask) && entitySet.insert(entity).second)
 						{
 							entityList.push_back(entity);
 						}
 					}
 				}
 
-				void removeEntity(Plugin::Entity * const entity)
+				// Removed entities are compacted out of the list in a single pass
+				void removeEntities(Plugin::Population::EntityBatch const &entityBatch)
 				{
 					concurrency::critical_section::scoped_lock lock(removeSection);
-					auto search = std::find_if(std::begin(entityList), std::end(entityList), [entity](Plugin::Entity * const search) -> bool
+					std::unordered_set<Plugin::Entity *> removedSet;
+					for (auto &entity : entityBatch)
 					{
-						return (entity == search);
-					});
+						if (entitySet.erase(entity) > 0)
+						{
+							removedSet.insert(entity);
+						}
+					}
 
-					if (search != std::end(entityList))
+					if (!removedSet.empty())
 					{
-						entityList.erase(search);
+						entityList.erase(std::remove_if(std::begin(entityList), std::end(entityList), [&](Plugin::Entity * const entity) -> bool
+						{
+							return (removedSet.count(entity) > 0);
+						}), std::end(entityList));
 					}
 				}
 
 				void clearEntities(void)
 				{
 					entityList.clear();
+					entitySet.clear();
 				}
 
 				void createBuffer(int32_t size = 0)
@@ -310,9 +317,10 @@ namespace Gek
 							auto &transformComponent = entity->getComponent<Components::Transform>();
 							auto &lightComponent = entity->getComponent<COMPONENT>();
 
-							shapeXPositionList[entityIndex] = transformComponent.position.x;
-							shapeYPositionList[entityIndex] = transformComponent.position.y;
-							shapeZPositionList[entityIndex] = transformComponent.position.z;
+							auto const &position = transformComponent.getWorldMatrix().translation;
+							shapeXPositionList[entityIndex] = position.x;
+							shapeYPositionList[entityIndex] = position.y;
+							shapeZPositionList[entityIndex] = position.z;
 							shapeRadiusList[entityIndex] = (lightComponent.range + lightComponent.radius);
 						});
 
@@ -332,6 +340,7 @@ namespace Gek
 			Video::Device *videoDevice = nullptr;
 			Plugin::Population *population = nullptr;
 			Engine::Resources *resources = nullptr;
+			Plugin::Option<bool> invertedDepthBuffer;
 
 			Video::SamplerStatePtr bufferSamplerState;
 			Video::SamplerStatePtr textureSamplerState;
@@ -413,13 +422,14 @@ namespace Gek
 				, spotLightThreadIdentifier(Hash(&spotLightData))
 			{
 				population->onReset.connect(this, &Renderer::onReset);
-				population->onEntityCreated.connect(this, &Renderer::onEntityCreated);
-				population->onEntityDestroyed.connect(this, &Renderer::onEntityDestroyed);
-				population->onComponentAdded.connect(this, &Renderer::onComponentAdded);
-				population->onComponentRemoved.connect(this, &Renderer::onComponentRemoved);
+				population->onEntitiesCreated.connect(this, &Renderer::onEntitiesCreated);
+				population->onEntitiesDestroyed.connect(this, &Renderer::onEntitiesDestroyed);
+				population->onComponentsAdded.connect(this, &Renderer::onComponentsAdded);
+				population->onComponentsRemoved.connect(this, &Renderer::onComponentsRemoved);
 				population->onUpdate[1000].connect(this, &Renderer::onUpdate);
 
 				core->setOption("render"s, "invertedDepthBuffer"s, true);
+				invertedDepthBuffer.connect(core, "render"sv, "invertedDepthBuffer"sv, true);
 
 				initializeSystem();
 				initializeUI();
@@ -713,31 +723,28 @@ namespace Gek
 				workerPool.drain();
 
 				population->onReset.disconnect(this, &Renderer::onReset);
-				population->onEntityCreated.disconnect(this, &Renderer::onEntityCreated);
-				population->onEntityDestroyed.disconnect(this, &Renderer::onEntityDestroyed);
-				population->onComponentAdded.disconnect(this, &Renderer::onComponentAdded);
-				population->onComponentRemoved.disconnect(this, &Renderer::onComponentRemoved);
+				population->onEntitiesCreated.disconnect(this, &Renderer::onEntitiesCreated);
+				population->onEntitiesDestroyed.disconnect(this, &Renderer::onEntitiesDestroyed);
+				population->onComponentsAdded.disconnect(this, &Renderer::onComponentsAdded);
+				population->onComponentsRemoved.disconnect(this, &Renderer::onComponentsRemoved);
 				population->onUpdate[1000].disconnect(this, &Renderer::onUpdate);
 
 				ImGui::GetIO().Fonts->TexID = 0;
 				ImGui::DestroyContext(gui.context);
 			}
 
-			void addEntity(Plugin::Entity * const entity)
+			void addEntities(Plugin::Population::EntityBatch const &entityBatch)
 			{
-				if (entity->hasComponents<Components::Transform, Components::Color>())
-				{
-					directionalLightData.addEntity(entity);
-					pointLightData.addEntity(entity);
-					spotLightData.addEntity(entity);
-				}
+				directionalLightData.addEntities(population, entityBatch);
+				pointLightData.addEntities(population, entityBatch);
+				spotLightData.addEntities(population, entityBatch);
 			}
 
-			void removeEntity(Plugin::Entity * const entity)
+			void removeEntities(Plugin::Population::EntityBatch const &entityBatch)
 			{
-				directionalLightData.removeEntity(entity);
-				pointLightData.removeEntity(entity);
-				spotLightData.removeEntity(entity);
+				directionalLightData.removeEntities(entityBatch);
+				pointLightData.removeEntities(entityBatch);
+				spotLightData.removeEntities(entityBatch);
 			}
 
 			// ImGui
@@ -862,26 +869,10 @@ namespace Gek
 			}
 
 			// Clustered Lighting
-			inline Math::Float3 getLightDirection(Math::Quaternion const &quaternion) const
+			inline Math::Float3 getLightDirection(Math::Float4x4 const &worldMatrix) const
 			{
-				const float xx(quaternion.x * quaternion.x);
-				const float yy(quaternion.y * quaternion.y);
-				const float zz(quaternion.z * quaternion.z);
-				const float ww(quaternion.w * quaternion.w);
-				const float length(xx + yy + zz + ww);
-				if (length == 0.0f)
-				{
-					return Math::Float3(0.0f, 1.0f, 0.0f);
-				}
-				else
-				{
-					const float determinant(1.0f / length);
-					const float xy(quaternion.x * quaternion.y);
-					const float xw(quaternion.x * quaternion.w);
-					const float yz(quaternion.y * quaternion.z);
-					const float zw(quaternion.z * quaternion.w);
-					return -Math::Float3((2.0f * (xy - zw) * determinant), ((-xx + yy - zz + ww) * determinant), (2.0f * (yz + xw) * determinant));
-				}
+				// Lights point down their local y axis, the world matrix is unscaled so no normalization is required
+				return -worldMatrix.ry.xyz;
 			}
 
 			inline void updateClipRegionRoot(float tangentCoordinate, float lightCoordinate, float lightDepth, float radius, float radiusSquared, float lightRangeSquared, float cameraScale, float& minimum, float& maximum) const
@@ -1030,7 +1021,7 @@ namespace Gek
 				auto lightIterator = pointLightData.lightList.grow_by(1);
 				PointLightData &lightData = (*lightIterator);
 				lightData.radiance = (colorComponent.value.xyz * lightComponent.intensity);
-				lightData.position = currentCamera.viewMatrix.transform(transformComponent.position);
+				lightData.position = currentCamera.viewMatrix.transform(transformComponent.getWorldPosition());
 				lightData.radius = lightComponent.radius;
 				lightData.range = lightComponent.range;
 
@@ -1046,10 +1037,10 @@ namespace Gek
 				auto lightIterator = spotLightData.lightList.grow_by(1);
 				SpotLightData &lightData = (*lightIterator);
 				lightData.radiance = (colorComponent.value.xyz * lightComponent.intensity);
-				lightData.position = currentCamera.viewMatrix.transform(transformComponent.position);
+				lightData.position = currentCamera.viewMatrix.transform(transformComponent.getWorldPosition());
 				lightData.radius = lightComponent.radius;
 				lightData.range = lightComponent.range;
-				lightData.direction = currentCamera.viewMatrix.rotate(getLightDirection(transformComponent.rotation));
+				lightData.direction = currentCamera.viewMatrix.rotate(getLightDirection(transformComponent.getWorldMatrix()));
 				lightData.innerAngle = lightComponent.innerAngle;
 				lightData.outerAngle = lightComponent.outerAngle;
 				lightData.coneFalloff = lightComponent.coneFalloff;
@@ -1066,24 +1057,24 @@ namespace Gek
 				spotLightData.clearEntities();
 			}
 
-			void onEntityCreated(Plugin::Entity * const entity)
+			void onEntitiesCreated(Plugin::Population::EntityBatch const &entityBatch)
 			{
-				addEntity(entity);
+				addEntities(entityBatch);
 			}
 
-			void onEntityDestroyed(Plugin::Entity * const entity)
+			void onEntitiesDestroyed(Plugin::Population::EntityBatch const &entityBatch)
 			{
-				removeEntity(entity);
+				removeEntities(entityBatch);
 			}
 
-			void onComponentAdded(Plugin::Entity * const entity)
+			void onComponentsAdded(Plugin::Population::EntityBatch const &entityBatch)
 			{
-				addEntity(entity);
+				addEntities(entityBatch);
 			}
 
-			void onComponentRemoved(Plugin::Entity * const entity)
+			void onComponentsRemoved(Plugin::Population::EntityBatch const &entityBatch)
 			{
-				removeEntity(entity);
+				removeEntities(entityBatch);
 			}
 
 			// Renderer
@@ -1117,7 +1108,7 @@ namespace Gek
 
 			void queueCamera(Math::Float4x4 const &viewMatrix, float fieldOfView, float aspectRatio, float nearClip, float farClip, std::string const &name, ResourceHandle cameraTarget, std::string const &forceShader)
 			{
-				if (core->getOption("render"s, "invertedDepthBuffer"s).convert(true))
+				if (invertedDepthBuffer.get())
 				{
 					queueCamera(viewMatrix, Math::Float4x4::MakePerspective(fieldOfView, aspectRatio, farClip, nearClip), nearClip, farClip, name, cameraTarget, forceShader);
 				}
@@ -1156,7 +1147,7 @@ namespace Gek
 					EngineConstantData engineConstantData;
 					engineConstantData.frameTime = frameTime;
 					engineConstantData.worldTime = 0.0f;
-					engineConstantData.invertedDepthBuffer = (core->getOption("render"s, "invertedDepthBuffer"s).convert(true) ? 1 : 0);
+					engineConstantData.invertedDepthBuffer = (invertedDepthBuffer.get() ? 1 : 0);
 					videoDevice->updateResource(engineConstantBuffer.get(), &engineConstantData);
 					Video::Device::Context *videoContext = videoDevice->getDefaultContext();
 					while (cameraQueue.try_pop(currentCamera))
@@ -1228,7 +1219,7 @@ namespace Gek
 
 												DirectionalLightData lightData;
 												lightData.radiance = (colorComponent.value.xyz * lightComponent.intensity);
-												lightData.direction = currentCamera.viewMatrix.rotate(getLightDirection(transformComponent.rotation));
+												lightData.direction = currentCamera.viewMatrix.rotate(getLightDirection(transformComponent.getWorldMatrix()));
 												directionalLightData.lightList.push_back(lightData);
 											});
 
@@ -1578,10 +1569,10 @@ namespace Gek
 							ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(5.0f, 10.0f));
 							if (ImGui::BeginMenu("Render"))
 							{
-								auto invertedDepthBuffer = core->getOption("render"s, "invertedDepthBuffer"s).convert(true);
-								if (ImGui::MenuItem("Inverted Depth Buffer", "CTRL+I", &invertedDepthBuffer))
+								bool invertDepthBuffer = invertedDepthBuffer.get();
+								if (ImGui::MenuItem("Inverted Depth Buffer", "CTRL+I", &invertDepthBuffer))
 								{
-									core->setOption("render"s, "invertedDepthBuffer"s, invertedDepthBuffer);
+									core->setOption("render"s, "invertedDepthBuffer"s, invertDepthBuffer);
 									reloadRequired = true;
 								}
 
@@ -1599,6 +1590,7 @@ namespace Gek
 					} GEK_VIDEO_PROFILER_END_SCOPE();
 
 					videoDevice->present(true);
+					resources->swapReloadedResources();
 
 					if (reloadRequired)
 					{
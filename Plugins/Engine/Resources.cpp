@@ -4,6 +4,8 @@
 #include "GEK/Utility/ThreadPool.hpp"
 #include "GEK/Utility/ShuntingYard.hpp"
 #include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/DerivedDataCache.hpp"
+#include "GEK/Utility/FileWatcher.hpp"
 #include "GEK/Utility/JSON.hpp"
 #include "GEK/Utility/ContextUser.hpp"
 #include "GEK/Shapes/Sphere.hpp"
@@ -26,6 +28,8 @@
 #include <concurrent_queue.h>
 #include <concurrent_vector.h>
 #include <ppl.h>
+#include <unordered_set>
+#include <mutex>
 
 class Float16Compressor
 {
@@ -102,7 +106,7 @@ namespace Gek
 {
     namespace Implementation
     {
-        static ShuntingYard shuntingYard;
+        thread_local ShuntingYard shuntingYard;
 
         template <class HANDLE, typename TYPE>
         class ResourceCache
@@ -148,6 +152,13 @@ namespace Gek
                 std::atomic_exchange(&atomicResource, data);
             }
 
+            // Returns the resource that was replaced, so the caller decides when it's released
+            TypePtr exchangeResource(HANDLE handle, TypePtr const &data)
+            {
+                auto &resourceSearch = resourceMap.insert(std::make_pair(handle, nullptr));
+                return std::atomic_exchange(&resourceSearch.first->second, data);
+            }
+
             virtual TYPE * const getResource(HANDLE handle) const
             {
                 if (handle.identifier >= validationIdentifier)
@@ -538,9 +549,24 @@ namespace Gek
             GeneralResourceCache<BlendStateHandle, Video::BlendState> blendStateCache;
 
             concurrency::concurrent_unordered_map<MaterialHandle, ShaderHandle> materialShaderMap;
-            concurrency::concurrent_unordered_map<ResourceHandle, Video::Texture::Description> textureDescriptionMap;
+            concurrency::concurrent_unordered_map<ResourceHandle, std::shared_ptr<Video::Texture::Description const>> textureDescriptionMap;
             concurrency::concurrent_unordered_map<ResourceHandle, Video::Buffer::Description> bufferDescriptionMap;
 
+            // Data files mapped to the resources loaded from them, so that a change only reloads what it affects
+            // Paths are normalized and relative to the data root, matching what the file watcher reports
+            std::mutex dependencyMutex;
+            std::unordered_map<std::string, std::unordered_set<std::size_t>> dependencyMap;
+            std::unordered_map<std::size_t, std::function<void(void)>> dependentMap;
+            FileWatcher::ListenerHandle fileListener = 0;
+
+            // Reloads are built on the load pool, but the renderer holds raw pointers from the caches for the length of
+            // a frame, so the swaps are queued and made on the render thread between frames
+            std::mutex swapMutex;
+            std::vector<std::function<void(void)>> pendingSwapList;
+
+            // Replaced by the last swaps, and released by the next so nothing from the frame before still points at them
+            std::vector<std::shared_ptr<void const>> retiredList;
+
             struct Validate
             {
                 bool state;
@@ -587,6 +613,11 @@ namespace Gek
                 core->onChangedSettings.connect(this, &Resources::onReload);
                 core->onInitialized.connect(this, &Resources::onInitialized);
                 core->onShutdown.connect(this, &Resources::onShutdown);
+
+                fileListener = getContext()->getFileWatcher()->addListener([this](std::vector<std::string> const &filePathList) -> void
+                {
+                    onDataFilesChanged(filePathList);
+                });
             }
 
             Validate &getValid(Video::Device::Context::Pipeline *videoPipeline)
@@ -934,13 +965,175 @@ namespace Gek
 
             void onShutdown(void)
             {
+                getContext()->getFileWatcher()->removeListener(fileListener);
+                clearDependencies();
                 loadPool.drain();
+                clearSwaps();
                 if (renderer)
                 {
                     renderer->onShowUserInterface.disconnect(this, &Resources::onShowUserInterface);
                 }
             }
 
+            // Dependents are keyed by resource type and handle, so registering again on reload doesn't add a second reload
+            void addDependencies(std::size_t dependent, std::vector<FileSystem::Path> const &filePathList, std::function<void(void)> &&reload)
+            {
+                std::unique_lock<std::mutex> lock(dependencyMutex);
+                for (auto const &filePath : filePathList)
+                {
+                    dependencyMap[Archive::GetNormalizedPath(filePath.getString())].insert(dependent);
+                }
+
+                dependentMap[dependent] = std::move(reload);
+            }
+
+            void clearDependencies(void)
+            {
+                std::unique_lock<std::mutex> lock(dependencyMutex);
+                dependencyMap.clear();
+                dependentMap.clear();
+            }
+
+            void queueSwap(std::function<void(void)> &&swap)
+            {
+                std::unique_lock<std::mutex> lock(swapMutex);
+                pendingSwapList.push_back(std::move(swap));
+            }
+
+            void clearSwaps(void)
+            {
+                std::unique_lock<std::mutex> lock(swapMutex);
+                pendingSwapList.clear();
+                retiredList.clear();
+            }
+
+            void reloadDependents(std::unordered_set<std::size_t> const &dependentSet)
+            {
+                std::vector<std::function<void(void)>> reloadList;
+                if (true)
+                {
+                    std::unique_lock<std::mutex> lock(dependencyMutex);
+                    for (auto dependent : dependentSet)
+                    {
+                        auto dependentSearch = dependentMap.find(dependent);
+                        if (dependentSearch != std::end(dependentMap))
+                        {
+                            reloadList.push_back(dependentSearch->second);
+                        }
+                    }
+                }
+
+                // Reloaded resources are built on the load pool and swapped in to their existing handles between frames
+                for (auto &reload : reloadList)
+                {
+                    loadPool.enqueueAndDetach(std::move(reload), __FILE__, __LINE__);
+                }
+            }
+
+            // Called on the file watcher thread
+            void onDataFilesChanged(std::vector<std::string> const &filePathList)
+            {
+                std::unordered_set<std::size_t> dependentSet;
+                if (true)
+                {
+                    std::unique_lock<std::mutex> lock(dependencyMutex);
+                    for (auto const &filePath : filePathList)
+                    {
+                        auto dependencySearch = dependencyMap.find(Archive::GetNormalizedPath(filePath));
+                        if (dependencySearch != std::end(dependencyMap))
+                        {
+                            LockedWrite{ std::cout } << "Reloading resources dependent on " << filePath;
+                            dependentSet.insert(std::begin(dependencySearch->second), std::end(dependencySearch->second));
+                        }
+                    }
+                }
+
+                reloadDependents(dependentSet);
+            }
+
+            Engine::MaterialPtr loadMaterialData(MaterialHandle handle, std::string const &materialName)
+            {
+                addDependencies(GetHash("material"sv, std::size_t(handle)), { FileSystem::CombinePaths("materials", materialName).withExtension(".json") }, [this, handle, materialName](void) -> void
+                {
+                    queueSwap([this, handle, material = std::shared_ptr<Engine::Material>(loadMaterialData(handle, materialName))](void) -> void
+                    {
+                        retiredList.push_back(materialCache.exchangeResource(handle, material));
+                    });
+                });
+
+                return getContext()->createClass<Engine::Material>("Engine::Material", (Engine::Resources *)this, materialName, handle);
+            }
+
+            Engine::ShaderPtr loadShaderData(ShaderHandle handle, std::string const &shaderName)
+            {
+                addDependencies(GetHash("shader"sv, std::size_t(handle)), { FileSystem::CombinePaths("shaders", shaderName).withExtension(".json") }, [this, handle, shaderName](void) -> void
+                {
+                    std::shared_ptr<Engine::Shader> shader;
+                    if (true)
+                    {
+                        std::unique_lock<std::recursive_mutex> lock(shaderMutex);
+                        shader = loadShaderData(handle, shaderName);
+                    }
+
+                    queueSwap([this, handle, shader](void) -> void
+                    {
+                        if (true)
+                        {
+                            std::unique_lock<std::recursive_mutex> lock(shaderMutex);
+                            retiredList.push_back(shaderCache.exchangeResource(handle, shader));
+                        }
+
+                        // Material data is laid out by the shader, so materials using it are rebuilt once it's swapped in
+                        std::unordered_set<std::size_t> materialSet;
+                        for (auto const &materialSearch : materialShaderMap)
+                        {
+                            if (materialSearch.second == handle)
+                            {
+                                materialSet.insert(GetHash("material"sv, std::size_t(materialSearch.first)));
+                            }
+                        }
+
+                        reloadDependents(materialSet);
+                    });
+                });
+
+                return getContext()->createClass<Engine::Shader>("Engine::Shader", core, shaderName);
+            }
+
+            Engine::FilterPtr loadFilterData(ResourceHandle handle, std::string const &filterName)
+            {
+                addDependencies(GetHash("filter"sv, std::size_t(handle)), { FileSystem::CombinePaths("filters", filterName).withExtension(".json") }, [this, handle, filterName](void) -> void
+                {
+                    queueSwap([this, handle, filter = std::shared_ptr<Engine::Filter>(loadFilterData(handle, filterName))](void) -> void
+                    {
+                        retiredList.push_back(filterCache.exchangeResource(handle, filter));
+                    });
+                });
+
+                return getContext()->createClass<Engine::Filter>("Engine::Filter", core, filterName);
+            }
+
+            Video::ProgramPtr loadProgramData(ProgramHandle handle, Video::Program::Type type, std::string const &name, std::string const &entryFunction, std::string const &engineData)
+            {
+                std::vector<FileSystem::Path> dependencyList;
+                auto compiledData = getProgramInformation(type, name, entryFunction, engineData, &dependencyList);
+                addDependencies(GetHash("program"sv, std::size_t(handle)), dependencyList, [this, handle, type, name, entryFunction, engineData](void) -> void
+                {
+                    queueSwap([this, handle, program = std::shared_ptr<Video::Program>(loadProgramData(handle, type, name, entryFunction, engineData))](void) -> void
+                    {
+                        retiredList.push_back(programCache.exchangeResource(handle, program));
+                    });
+                });
+
+                auto program = videoDevice->createProgram(compiledData);
+                if (program)
+                {
+                    program->setName(String::Format("{}:{}", name, entryFunction));
+                }
+
+                return program;
+            }
+
             // Plugin::Core Slots
             void onReload(void)
             {
@@ -964,7 +1157,7 @@ namespace Gek
                 auto hash = GetHash(materialName);
                 return materialCache.getHandle(hash, [this, materialName = std::string(materialName)](MaterialHandle handle)->Engine::MaterialPtr
 				{
-					return getContext()->createClass<Engine::Material>("Engine::Material", (Engine::Resources *)this, materialName, handle);
+					return loadMaterialData(handle, materialName);
 				}).second;
             }
 
@@ -987,7 +1180,8 @@ namespace Gek
 				auto hash = GetHash(textureName);
 				for (auto const &format : formatList)
                 {
-                    auto texturePath(getContext()->findDataPath(FileSystem::CombinePaths("textures", textureName).withExtension(format)));
+                    auto textureFile(FileSystem::CombinePaths("textures", textureName).withExtension(format));
+                    auto texturePath(getContext()->findDataPath(textureFile));
                     if (texturePath.isFile())
                     {
                         auto resource = dynamicCache.getHandle(hash, flags, [this, filePath = FileSystem::Path(texturePath), textureName = std::string(textureName), flags](ResourceHandle)->Video::TexturePtr
@@ -998,7 +1192,16 @@ namespace Gek
                         if (resource.first)
                         {
                             auto description = videoDevice->loadTextureDescription(texturePath);
-                            textureDescriptionMap.insert(std::make_pair(resource.second, description));
+                            textureDescriptionMap.insert(std::make_pair(resource.second, std::make_shared<Video::Texture::Description const>(description)));
+                            addDependencies(GetHash("texture"sv, std::size_t(resource.second)), { textureFile }, [this, handle = resource.second, filePath = FileSystem::Path(texturePath), textureName = std::string(textureName), flags](void) -> void
+                            {
+                                auto description = std::make_shared<Video::Texture::Description const>(videoDevice->loadTextureDescription(filePath));
+                                queueSwap([this, handle, description, texture = std::shared_ptr<Video::Object>(loadTextureData(filePath, textureName, flags))](void) -> void
+                                {
+                                    retiredList.push_back(std::atomic_exchange(&textureDescriptionMap[handle], description));
+                                    retiredList.push_back(dynamicCache.exchangeResource(handle, texture));
+                                });
+                            });
                         }
 
                         return resource.second;
@@ -1124,7 +1327,7 @@ namespace Gek
 
                 if (resource.first)
                 {
-                    textureDescriptionMap.insert(std::make_pair(resource.second, description));
+                    textureDescriptionMap.insert(std::make_pair(resource.second, std::make_shared<Video::Texture::Description const>(description)));
                 }
 
                 return resource.second;
@@ -1152,7 +1355,7 @@ namespace Gek
 
                 if (resource.first)
                 {
-                    textureDescriptionMap.insert(std::make_pair(resource.second, description));
+                    textureDescriptionMap.insert(std::make_pair(resource.second, std::make_shared<Video::Texture::Description const>(description)));
                 }
 
                 return resource.second;
@@ -1366,9 +1569,11 @@ namespace Gek
             // Engine::Resources
             void clear(void)
             {
+                clearDependencies();
                 textureDescriptionMap.clear();
                 bufferDescriptionMap.clear();
                 loadPool.drain();
+                clearSwaps();
                 materialShaderMap.clear();
                 programCache.clear();
                 materialCache.clear();
@@ -1385,6 +1590,23 @@ namespace Gek
                 onReload();
             }
 
+            void swapReloadedResources(void)
+            {
+                std::vector<std::function<void(void)>> swapList;
+                if (true)
+                {
+                    std::unique_lock<std::mutex> lock(swapMutex);
+                    swapList.swap(pendingSwapList);
+                }
+
+                // Only the render thread touches the retired list outside of a clear
+                retiredList.clear();
+                for (auto &swap : swapList)
+                {
+                    swap();
+                }
+            }
+
             ShaderHandle getMaterialShader(MaterialHandle material) const
             {
                 auto shaderSearch = materialShaderMap.find(material);
@@ -1411,9 +1633,9 @@ namespace Gek
                 std::unique_lock<std::recursive_mutex> lock(shaderMutex);
 
                 auto hash = GetHash(shaderName);
-                auto resource = shaderCache.getHandle(hash, [this, shaderName = std::string(shaderName)](ShaderHandle)->Engine::ShaderPtr
+                auto resource = shaderCache.getHandle(hash, [this, shaderName = std::string(shaderName)](ShaderHandle handle)->Engine::ShaderPtr
 				{
-					return getContext()->createClass<Engine::Shader>("Engine::Shader", core, shaderName);
+					return loadShaderData(handle, shaderName);
 				});
 
 				if (material && resource.second)
@@ -1427,9 +1649,9 @@ namespace Gek
             Engine::Filter * const getFilter(std::string_view filterName)
             {
                 auto hash = GetHash(filterName);
-                auto resource = filterCache.getHandle(hash, [this, filterName = std::string(filterName)](ResourceHandle)->Engine::FilterPtr
+                auto resource = filterCache.getHandle(hash, [this, filterName = std::string(filterName)](ResourceHandle handle)->Engine::FilterPtr
 				{
-					return getContext()->createClass<Engine::Filter>("Engine::Filter", core, filterName);
+					return loadFilterData(handle, filterName);
 				});
 
 				return filterCache.getResource(resource.second);
@@ -1442,10 +1664,11 @@ namespace Gek
                     return &videoDevice->getBackBuffer()->getDescription();
                 }
 
+                // A reloaded description replaces the old one between frames, and the old one is kept for a frame after
                 auto descriptionSearch = textureDescriptionMap.find(resourceHandle);
                 if (descriptionSearch != std::end(textureDescriptionMap))
                 {
-                    return &descriptionSearch->second;
+                    return std::atomic_load(&descriptionSearch->second).get();
                 }
                 else
                 {
@@ -1476,74 +1699,112 @@ namespace Gek
                 return dynamicCache.getResource(resourceHandle);
             }
 
-			Video::Program::Information getProgramInformation(Video::Program::Type type, std::string_view name, std::string_view entryFunction, std::string_view engineData)
+			Video::Program::Information getProgramInformation(Video::Program::Type type, std::string_view name, std::string_view entryFunction, std::string_view engineData, std::vector<FileSystem::Path> *dependencyList = nullptr)
             {
 				auto programsPath(getContext()->findDataPath("programs"s, false));
 				auto filePath(FileSystem::CombinePaths(programsPath, name));
 				auto programDirectory(filePath.getParentPath());
 				std::string uncompiledData(FileSystem::Load(filePath, std::string(engineData)));
 
-				auto hash = GetHash(name, uncompiledData, engineData);
+				// Dependencies are relative to the data root, the same as the paths reported by the file watcher
+				auto addDependency = [programsPath, dependencyList](FileSystem::Path const &dependencyPath) -> void
+				{
+					if (dependencyList)
+					{
+						dependencyList->push_back("programs"s + dependencyPath.getString().substr(programsPath.getString().size()));
+					}
+				};
+
+				auto loadInclude = [programsPath, programDirectory, &addDependency](Video::IncludeType includeType, std::string_view fileName, std::string &includeData) -> bool
+				{
+					auto includePath(FileSystem::CombinePaths((includeType == Video::IncludeType::Local ? programDirectory : programsPath), fileName));
+					if (includePath.isFile())
+					{
+						addDependency(includePath);
+						includeData = FileSystem::Load(includePath, String::Empty);
+						return true;
+					}
+
+					return false;
+				};
+
+				addDependency(filePath);
+
+				// Bump whenever the layout of the entry or the compiler settings change
+				static constexpr uint32_t ProgramCacheVersion = 1;
+				DerivedDataCache::Key key("program", ProgramCacheVersion);
+				key.addValue(type).add(name).add(entryFunction).add(engineData).add(uncompiledData);
+
 				auto cachePath = getContext()->getCachePath(FileSystem::CombinePaths("programs", name));
-				auto uncompiledPath(cachePath.withExtension(String::Format(".{}.hlsl", hash)));
-				auto compiledPath(cachePath.withExtension(String::Format(".{}.bin", hash)));
+				auto uncompiledPath(cachePath.withExtension(String::Format(".{}.hlsl", key.getHash())));
 				Video::Program::Information information =
 				{
 					type
 				};
 
-                if (compiledPath.isFile())
-                {
-					static const std::vector<uint8_t> EmptyBuffer;
-					information.compiledData = FileSystem::Load(compiledPath, EmptyBuffer);
+				// Entries start with the includes used to compile them, as type, name and a hash of their contents
+				// Includes aren't known until the program is compiled, so they're checked against the disk when loaded
+				auto derivedDataCache = getContext()->getDerivedDataCache();
+				Archive::Data cachedData;
+				if (derivedDataCache && derivedDataCache->load(key, cachedData))
+				{
+					size_t offset = 0;
+					auto readValue = [&](auto &value) -> bool
+					{
+						if ((offset + sizeof(value)) > cachedData.size())
+						{
+							return false;
+						}
+
+						std::memcpy(&value, cachedData.data() + offset, sizeof(value));
+						offset += sizeof(value);
+						return true;
+					};
+
+					uint32_t includeCount = 0;
+					bool includesMatch = readValue(includeCount);
+					for (uint32_t includeIndex = 0; includesMatch && includeIndex < includeCount; ++includeIndex)
+					{
+						Video::IncludeType includeType;
+						uint32_t nameSize = 0;
+						uint64_t includeHash = 0;
+						includesMatch = (readValue(includeType) && readValue(nameSize) && (offset + nameSize) <= cachedData.size());
+						if (includesMatch)
+						{
+							std::string_view includeName(reinterpret_cast<char const *>(cachedData.data() + offset), nameSize);
+							offset += nameSize;
+
+							std::string includeData;
+							includesMatch = (readValue(includeHash) && loadInclude(includeType, includeName, includeData) && DerivedDataCache::GetHash(includeData) == includeHash);
+						}
+					}
+
+					if (includesMatch)
+					{
+						information.compiledData.assign(cachedData.begin() + offset, cachedData.end());
+					}
 				}
-                
+
                 if (information.compiledData.empty())
                 {
-					std::map<std::string_view, std::string> includedMap;
-					auto onInclude = [programsPath, programDirectory, &includedMap, engineData](Video::IncludeType includeType, std::string_view fileName, void const **data, uint32_t *size) -> bool
+					std::map<std::string, std::pair<Video::IncludeType, std::string>> includedMap;
+					auto onInclude = [&loadInclude, &includedMap, engineData](Video::IncludeType includeType, std::string_view fileName, void const **data, uint32_t *size) -> bool
 					{
-						std::string includeData;
 						if (String::GetLower(fileName) == "gekengine"s)
 						{
 							(*data) = engineData.data();
 							(*size) = engineData.size();
 							return true;
 						}
-						else
-						{
-							switch (includeType)
-							{
-							case Video::IncludeType::Local:
-								if (true)
-								{
-									auto localPath(FileSystem::CombinePaths(programDirectory, fileName));
-									if (localPath.isFile())
-									{
-										includedMap[fileName] = FileSystem::Load(localPath, String::Empty);
-										(*data) = includedMap[fileName].data();
-										(*size) = includedMap[fileName].size();
-										return true;
-									}
-								}
-
-								break;
 
-							case Video::IncludeType::Global:
-								if (true)
-								{
-									auto rootPath(FileSystem::CombinePaths(programsPath, fileName));
-									if (rootPath.isFile())
-									{
-										includedMap[fileName] = FileSystem::Load(rootPath, String::Empty);
-										(*data) = includedMap[fileName].data();
-										(*size) = includedMap[fileName].size();
-										return true;
-									}
-								}
-
-								break;
-							};
+						std::string includeData;
+						if (loadInclude(includeType, fileName, includeData))
+						{
+							auto &included = includedMap[std::string(fileName)];
+							included = std::make_pair(includeType, std::move(includeData));
+							(*data) = included.second.data();
+							(*size) = included.second.size();
+							return true;
 						}
 
 						return false;
@@ -1551,7 +1812,30 @@ namespace Gek
 
 					information = videoDevice->compileProgram(type, name, uncompiledPath, uncompiledData, entryFunction, onInclude);
 					FileSystem::Save(uncompiledPath, information.uncompiledData);
-					FileSystem::Save(compiledPath, information.compiledData);
+					if (derivedDataCache && !information.compiledData.empty())
+					{
+						std::vector<uint8_t> entryData;
+						auto writeValue = [&](void const *data, size_t size) -> void
+						{
+							auto byteData = static_cast<uint8_t const *>(data);
+							entryData.insert(std::end(entryData), byteData, byteData + size);
+						};
+
+						uint32_t includeCount = includedMap.size();
+						writeValue(&includeCount, sizeof(uint32_t));
+						for (auto const &included : includedMap)
+						{
+							uint32_t nameSize = included.first.size();
+							uint64_t includeHash = DerivedDataCache::GetHash(included.second.second);
+							writeValue(&included.second.first, sizeof(Video::IncludeType));
+							writeValue(&nameSize, sizeof(uint32_t));
+							writeValue(included.first.data(), nameSize);
+							writeValue(&includeHash, sizeof(uint64_t));
+						}
+
+						writeValue(information.compiledData.data(), information.compiledData.size());
+						derivedDataCache->store(key, entryData);
+					}
 				}
 				else
 				{
@@ -1581,16 +1865,9 @@ namespace Gek
 
 			ProgramHandle loadProgram(Video::Program::Type type, std::string_view name, std::string_view entryFunction, std::string_view engineData)
 			{
-				return programCache.getHandle([this, type, name = std::string(name), entryFunction = std::string(entryFunction), engineData = std::string(engineData)](ProgramHandle)->Video::ProgramPtr
+				return programCache.getHandle([this, type, name = std::string(name), entryFunction = std::string(entryFunction), engineData = std::string(engineData)](ProgramHandle handle)->Video::ProgramPtr
 				{
-					auto compiledData = getProgramInformation(type, name, entryFunction, engineData);
-					auto program = videoDevice->createProgram(compiledData);
-                    if (program)
-                    {
-                        program->setName(String::Format("{}:{}", name, entryFunction));
-                    }
-
-                    return program;
+					return loadProgramData(handle, type, name, entryFunction, engineData);
 				});
 			}
 
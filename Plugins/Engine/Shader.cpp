@@ -114,10 +114,15 @@ namespace Gek
                 auto &backBufferDescription = backBuffer->getDescription();
 
                 JSON rootNode;
-                rootNode.load(getContext()->findDataPath(FileSystem::CombinePaths("shaders", shaderName).withExtension(".json")));
+                Archive::Data rootData;
+                if (getContext()->loadDataFile(FileSystem::CombinePaths("shaders", shaderName).withExtension(".json"), rootData))
+                {
+                    rootNode.parse(rootData.getString(), shaderName);
+                }
+
                 outputResource = rootNode.getMember("output"sv).convert(String::Empty);
 
-                ShuntingYard shuntingYard(population->getShuntingYard());
+                ShuntingYard shuntingYard;
                 const auto &coreOptionsNode = core->getOption("shaders", shaderName);
                 for (const auto &coreValuePair : coreOptionsNode.asType(JSON::EmptyObject))
                 {
@@ -134,10 +139,19 @@ namespace Gek
                 auto importSearch = rootOptionsObject.find("#import");
                 if (importSearch != std::end(rootOptionsObject))
                 {
+                    // Imports add members, so take the import list out before they move
+                    auto importNode(std::move(importSearch->second));
+                    rootOptionsObject.erase(importSearch);
+
                     auto importExternal = [&](std::string_view importName) -> void
                     {
                         JSON importOptions;
-                        importOptions.load(getContext()->findDataPath(FileSystem::CombinePaths("shaders", importName).withExtension(".json")));
+                        Archive::Data importOptionsData;
+                        if (getContext()->loadDataFile(FileSystem::CombinePaths("shaders", importName).withExtension(".json"), importOptionsData))
+                        {
+                            importOptions.parse(importOptionsData.getString(), importName);
+                        }
+
                         for (auto &importPair : importOptions.asType(JSON::EmptyObject))
                         {
                             if (rootOptionsObject.count(importPair.first) == 0)
@@ -147,7 +161,7 @@ namespace Gek
                         }
                     };
 
-                    importSearch->second.visit(
+                    importNode.visit(
                         [&](std::string const &importName)
                     {
                         importExternal(importName);
@@ -162,8 +176,6 @@ namespace Gek
                         [&](auto const &)
                     {
                     });
-
-                    rootOptionsObject.erase(importSearch);
                 }
 
                 core->setOption("shaders", shaderName, rootOptionsNode);
@@ -32,7 +32,11 @@ namespace Gek
                 assert(resources);
 
                 JSON visualNode;
-                visualNode.load(getContext()->findDataPath(FileSystem::CombinePaths("visuals", visualName).withExtension(".json")));
+                Archive::Data visualData;
+                if (getContext()->loadDataFile(FileSystem::CombinePaths("visuals", visualName).withExtension(".json"), visualData))
+                {
+                    visualNode.parse(visualData.getString(), visualName);
+                }
 
 				std::string inputVertexData;
 				std::vector<Video::InputElement> elementList;
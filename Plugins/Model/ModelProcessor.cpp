@@ -3,6 +3,7 @@
 #include "GEK/Shapes/AlignedBox.hpp"
 #include "GEK/Utility/String.hpp"
 #include "GEK/Utility/ThreadPool.hpp"
+#include "GEK/Utility/IOService.hpp"
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/JSON.hpp"
 #include "GEK/Utility/Allocator.hpp"
@@ -24,8 +25,11 @@
 #include <concurrent_vector.h>
 #include <xmmintrin.h>
 #include <algorithm>
+#include <unordered_map>
+#include <condition_variable>
 #include <memory>
 #include <future>
+#include <mutex>
 #include <ppl.h>
 #include <array>
 #include <map>
@@ -60,6 +64,16 @@ namespace Gek
             data->name = evaluate(importData, String::Empty);
         }
 
+        void save(Components::Model const * const data, BinaryWriter &exportData) const
+        {
+            exportData.writeString(data->name);
+        }
+
+        void load(Components::Model * const data, BinaryReader &importData)
+        {
+            data->name = importData.readString();
+        }
+
         // Edit::Component
         bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
         {
@@ -239,6 +253,12 @@ namespace Gek
         Video::BufferPtr instanceBuffer;
         ThreadPool<5> loadPool;
 
+        // Reads in flight by the model they load, each removes itself when its data is dispatched
+        std::mutex readMutex;
+        std::condition_variable readCondition;
+        std::unordered_map<Group::Model const *, IOService::Request> readRequestMap;
+        bool stopReading = false;
+
         concurrency::concurrent_unordered_map<std::size_t, Group> groupMap;
 
         std::vector<float, AlignedAllocator<float, 16>> halfSizeXList;
@@ -277,10 +297,10 @@ namespace Gek
             core->onInitialized.connect(this, &ModelProcessor::onInitialized);
             core->onShutdown.connect(this, &ModelProcessor::onShutdown);
             population->onReset.connect(this, &ModelProcessor::onReset);
-            population->onEntityCreated.connect(this, &ModelProcessor::onEntityCreated);
-            population->onEntityDestroyed.connect(this, &ModelProcessor::onEntityDestroyed);
-            population->onComponentAdded.connect(this, &ModelProcessor::onComponentAdded);
-            population->onComponentRemoved.connect(this, &ModelProcessor::onComponentRemoved);
+            population->onEntitiesCreated.connect(this, &ModelProcessor::onEntitiesCreated);
+            population->onEntitiesDestroyed.connect(this, &ModelProcessor::onEntitiesDestroyed);
+            population->onComponentsAdded.connect(this, &ModelProcessor::onComponentsAdded);
+            population->onComponentsRemoved.connect(this, &ModelProcessor::onComponentsRemoved);
             renderer->onQueueDrawCalls.connect(this, &ModelProcessor::onQueueDrawCalls);
 
             visual = resources->loadVisual("model");
@@ -294,9 +314,9 @@ namespace Gek
             instanceBuffer->setName("model:instances");
         }
 
-        void addEntity(Plugin::Entity * const entity)
+        void addEntities(Plugin::Population::EntityBatch const &entityBatch)
         {
-            EntityProcessor::addEntity(entity, [&](bool isNewInsert, auto &data, auto &modelComponent, auto &transformComponent) -> void
+            EntityProcessor::addEntities(population, entityBatch, [&](bool isNewInsert, auto &data, auto &modelComponent, auto &transformComponent) -> void
             {
                 static const Group BlankGroup;
                 auto pair = groupMap.insert(std::make_pair(GetHash(modelComponent.name), BlankGroup));
@@ -305,40 +325,12 @@ namespace Gek
                     LockedWrite{ std::cout } << "Queueing group for load: " << modelComponent.name;
                     loadPool.enqueueAndDetach([this, name = modelComponent.name, &group = pair.first->second](void) -> void
                     {
+                        // Headers are checked when each model loads, so listing the group doesn't open any files
                         std::vector<FileSystem::Path> modelPathList;
-                        auto groupPath(getContext()->findDataPath(FileSystem::CombinePaths("models", name)));
-                        groupPath.findFiles([&](FileSystem::Path const &filePath) -> bool
+                        getContext()->findDataFiles(FileSystem::CombinePaths("models", name), [&](FileSystem::Path const &filePath) -> bool
                         {
-                            std::string fileName(filePath.getString());
-                            if (filePath.isFile() && String::GetLower(filePath.getExtension()) == ".gek")
+                            if (String::GetLower(filePath.getExtension()) == ".gek")
                             {
-                                static const std::vector<uint8_t> EmptyBuffer;
-                                std::vector<uint8_t> buffer(FileSystem::Load(filePath, EmptyBuffer, sizeof(Header)));
-                                if (buffer.size() < sizeof(Header))
-                                {
-                                    LockedWrite{ std::cerr } << "Model file too small to contain header: " << fileName;
-                                    return true;
-                                }
-
-                                Header *header = (Header *)buffer.data();
-                                if (header->identifier != *(uint32_t *)"GEKX")
-                                {
-                                    LockedWrite{ std::cerr } << "Unknown model file identifier encountered (requires: GEKX, has: " << header->identifier << "): " << fileName;
-                                    return true;
-                                }
-
-                                if (header->type != 0)
-                                {
-                                    LockedWrite{ std::cerr } << "Unsupported model type encountered (requires: 0, has: " << header->type << "): " << fileName;
-                                    return true;
-                                }
-
-                                if (header->version != 8)
-                                {
-                                    LockedWrite{ std::cerr } << "Unsupported model version encountered (requires: 8, has: " << header->version << "): " << fileName;
-                                    return true;
-                                }
-
                                 modelPathList.push_back(filePath);
                             }
 
@@ -355,15 +347,52 @@ namespace Gek
                         {
                             auto &model = group.modelList[modelIndex];
                             auto &filePath = modelPathList[modelIndex];
-                            loadPool.enqueueAndDetach([this, name = name, filePath, &group, &model](void) -> void
+
+                            // Held while the read is issued, so the dispatch can't remove the request before it's added
+                            std::unique_lock<std::mutex> lock(readMutex);
+                            if (stopReading)
+                            {
+                                break;
+                            }
+
+                            // The read waits on the I/O thread, parsing continues on the load pool once the data is in memory
+                            auto readRequest = getContext()->getIOService()->read(filePath, IOService::Priority::Normal, [this, name = name, filePath, &group, &model](Archive::Data &&file) -> void
                             {
                                 auto fileName(filePath.getFileName());
 
-                                static const std::vector<uint8_t> EmptyBuffer;
-                                std::vector<uint8_t> buffer(FileSystem::Load(filePath, EmptyBuffer));
+                                // Buffers are created straight from the mapped view, the file is never copied in to a temporary
+                                if (file.empty())
+                                {
+                                    LockedWrite{ std::cerr } << "Unable to load model file: " << filePath.getString();
+                                    return;
+                                }
+
+                                auto header = file.getData<Header>();
+                                if (!header)
+                                {
+                                    LockedWrite{ std::cerr } << "Model file too small to contain header: " << filePath.getString();
+                                    return;
+                                }
+
+                                if (header->identifier != *(uint32_t *)"GEKX")
+                                {
+                                    LockedWrite{ std::cerr } << "Unknown model file identifier encountered (requires: GEKX, has: " << header->identifier << "): " << filePath.getString();
+                                    return;
+                                }
 
-                                Header *header = (Header *)buffer.data();
-                                if (buffer.size() < (sizeof(Header) + (sizeof(Header::Mesh) * header->meshCount)))
+                                if (header->type != 0)
+                                {
+                                    LockedWrite{ std::cerr } << "Unsupported model type encountered (requires: 0, has: " << header->type << "): " << filePath.getString();
+                                    return;
+                                }
+
+                                if (header->version != 8)
+                                {
+                                    LockedWrite{ std::cerr } << "Unsupported model version encountered (requires: 8, has: " << header->version << "): " << filePath.getString();
+                                    return;
+                                }
+
+                                if (file.size() < (sizeof(Header) + (sizeof(Header::Mesh) * header->meshCount)))
                                 {
                                     LockedWrite{ std::cerr } << "Model file too small to contain mesh headers: " << filePath.getString();
                                     return;
@@ -375,49 +404,71 @@ namespace Gek
                                 group.boundingBox.extend(model.boundingBox.minimum);
                                 group.boundingBox.extend(model.boundingBox.maximum);
                                 model.meshList.resize(header->meshCount);
-                                uint8_t *bufferData = (uint8_t *)&header->meshList[header->meshCount];
+                                uint8_t const *bufferData = reinterpret_cast<uint8_t const *>(&header->meshList[header->meshCount]);
                                 for (uint32_t meshIndex = 0; meshIndex < header->meshCount; ++meshIndex)
                                 {
-                                    Header::Mesh &meshHeader = header->meshList[meshIndex];
+                                    Header::Mesh const &meshHeader = header->meshList[meshIndex];
                                     Group::Model::Mesh &mesh = model.meshList[meshIndex];
 
+                                    const size_t meshSize = ((sizeof(Face) * meshHeader.faceCount) + (((sizeof(Math::Float3) * 4) + sizeof(Math::Float2)) * meshHeader.vertexCount));
+                                    if (size_t(file.end() - bufferData) < meshSize)
+                                    {
+                                        LockedWrite{ std::cerr } << "Model file too small to contain mesh data: " << filePath.getString();
+                                        return;
+                                    }
+
                                     mesh.material = resources->loadMaterial(meshHeader.material);
 
                                     Video::Buffer::Description indexBufferDescription;
                                     indexBufferDescription.format = Video::Format::R16_UINT;
                                     indexBufferDescription.count = (meshHeader.faceCount * 3);
                                     indexBufferDescription.type = Video::Buffer::Type::Index;
-                                    mesh.indexBuffer = resources->createBuffer(String::Format("model:{}.{}.{}:indices", meshIndex, fileName, name), indexBufferDescription, reinterpret_cast<uint16_t *>(bufferData));
+                                    mesh.indexBuffer = resources->createBuffer(String::Format("model:{}.{}.{}:indices", meshIndex, fileName, name), indexBufferDescription, reinterpret_cast<uint16_t const *>(bufferData));
                                     bufferData += (sizeof(Face) * meshHeader.faceCount);
 
                                     Video::Buffer::Description vertexBufferDescription;
                                     vertexBufferDescription.stride = sizeof(Math::Float3);
                                     vertexBufferDescription.count = meshHeader.vertexCount;
                                     vertexBufferDescription.type = Video::Buffer::Type::Vertex;
-                                    mesh.vertexBufferList[0] = resources->createBuffer(String::Format("model:{}.{}.{}:positions", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 *>(bufferData));
+                                    mesh.vertexBufferList[0] = resources->createBuffer(String::Format("model:{}.{}.{}:positions", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float3) * meshHeader.vertexCount);
 
                                     vertexBufferDescription.stride = sizeof(Math::Float2);
-                                    mesh.vertexBufferList[1] = resources->createBuffer(String::Format("model:{}.{}.{}:texcoords", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float2 *>(bufferData));
+                                    mesh.vertexBufferList[1] = resources->createBuffer(String::Format("model:{}.{}.{}:texcoords", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float2 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float2) * meshHeader.vertexCount);
 
                                     vertexBufferDescription.stride = sizeof(Math::Float3);
-                                    mesh.vertexBufferList[2] = resources->createBuffer(String::Format("model:{}.{}.{}:tangents", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 *>(bufferData));
+                                    mesh.vertexBufferList[2] = resources->createBuffer(String::Format("model:{}.{}.{}:tangents", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float3) * meshHeader.vertexCount);
 
                                     vertexBufferDescription.stride = sizeof(Math::Float3);
-                                    mesh.vertexBufferList[3] = resources->createBuffer(String::Format("model:{}.{}.{}:bitangents", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 *>(bufferData));
+                                    mesh.vertexBufferList[3] = resources->createBuffer(String::Format("model:{}.{}.{}:bitangents", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float3) * meshHeader.vertexCount);
 
                                     vertexBufferDescription.stride = sizeof(Math::Float3);
-                                    mesh.vertexBufferList[4] = resources->createBuffer(String::Format("model:{}.{}.{}:normals", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 *>(bufferData));
+                                    mesh.vertexBufferList[4] = resources->createBuffer(String::Format("model:{}.{}.{}:normals", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float3) * meshHeader.vertexCount);
 
                                     mesh.indexCount = indexBufferDescription.count;
                                 }
 
                                 LockedWrite{ std::cout } << "Group " << name << ", mesh " << fileName << " successfully loaded";
-                            }, __FILE__, __LINE__);
+                            }, [this, &model](std::function<void(void)> &&task) -> void
+                            {
+                                std::unique_lock<std::mutex> lock(readMutex);
+                                readRequestMap.erase(&model);
+                                if (!stopReading)
+                                {
+                                    loadPool.enqueueAndDetach(std::move(task), __FILE__, __LINE__);
+                                }
+
+                                readCondition.notify_all();
+                            });
+
+                            if (readRequest != IOService::InvalidRequest)
+                            {
+                                readRequestMap[&model] = readRequest;
+                            }
                         }
 
                         LockedWrite{ std::cout } << "Group " << name << " successfully queued";
@@ -443,6 +494,30 @@ namespace Gek
 
         void onShutdown(void)
         {
+            // Reads are cancelled before the pool is drained, so no parse can be queued on the pool once it's stopped
+            if (true)
+            {
+                std::unique_lock<std::mutex> lock(readMutex);
+                stopReading = true;
+                for (auto readSearch = std::begin(readRequestMap); readSearch != std::end(readRequestMap); )
+                {
+                    if (getContext()->getIOService()->cancel(readSearch->second))
+                    {
+                        readSearch = readRequestMap.erase(readSearch);
+                    }
+                    else
+                    {
+                        ++readSearch;
+                    }
+                }
+
+                // The rest are being dispatched, they drop their parse and remove themselves once they get the lock
+                readCondition.wait(lock, [this](void) -> bool
+                {
+                    return readRequestMap.empty();
+                });
+            }
+
             loadPool.drain();
             if (events)
             {
@@ -450,10 +525,10 @@ namespace Gek
             }
 
             population->onReset.disconnect(this, &ModelProcessor::onReset);
-            population->onEntityCreated.disconnect(this, &ModelProcessor::onEntityCreated);
-            population->onEntityDestroyed.disconnect(this, &ModelProcessor::onEntityDestroyed);
-            population->onComponentAdded.disconnect(this, &ModelProcessor::onComponentAdded);
-            population->onComponentRemoved.disconnect(this, &ModelProcessor::onComponentRemoved);
+            population->onEntitiesCreated.disconnect(this, &ModelProcessor::onEntitiesCreated);
+            population->onEntitiesDestroyed.disconnect(this, &ModelProcessor::onEntitiesDestroyed);
+            population->onComponentsAdded.disconnect(this, &ModelProcessor::onComponentsAdded);
+            population->onComponentsRemoved.disconnect(this, &ModelProcessor::onComponentsRemoved);
             renderer->onQueueDrawCalls.disconnect(this, &ModelProcessor::onQueueDrawCalls);
         }
 
@@ -474,7 +549,7 @@ namespace Gek
         {
             if (type == Components::Model::GetIdentifier())
             {
-                addEntity(entity);
+                addEntities({ entity });
             }
         }
 
@@ -484,24 +559,24 @@ namespace Gek
             clear();
         }
 
-        void onEntityCreated(Plugin::Entity * const entity)
+        void onEntitiesCreated(Plugin::Population::EntityBatch const &entityBatch)
         {
-            addEntity(entity);
+            addEntities(entityBatch);
         }
 
-        void onEntityDestroyed(Plugin::Entity * const entity)
+        void onEntitiesDestroyed(Plugin::Population::EntityBatch const &entityBatch)
         {
-            removeEntity(entity);
+            removeEntities(entityBatch);
         }
 
-        void onComponentAdded(Plugin::Entity * const entity)
+        void onComponentsAdded(Plugin::Population::EntityBatch const &entityBatch)
         {
-            addEntity(entity);
+            addEntities(entityBatch);
         }
 
-        void onComponentRemoved(Plugin::Entity * const entity)
+        void onComponentsRemoved(Plugin::Population::EntityBatch const &entityBatch)
         {
-            removeEntity(entity);
+            removeEntities(entityBatch);
         }
 
         // Plugin::Renderer Slots
@@ -531,7 +606,7 @@ namespace Gek
 					parallelListEntities([&](Plugin::Entity * const entity, auto &data, auto &modelComponent, auto &transformComponent) -> void
 					{
 						auto group = data.group;
-						auto matrix(transformComponent.getMatrix());
+						auto matrix(transformComponent.getWorldMatrix());
 						matrix.translation.xyz += group->boundingBox.getCenter();
 						auto halfSize(group->boundingBox.getHalfSize() * transformComponent.scale);
 
@@ -591,7 +666,7 @@ namespace Gek
 							auto group = data->group;
 
 							auto &transformComponent = entity->getComponent<Components::Transform>();
-							auto matrix(transformComponent.getMatrix());
+							auto matrix(transformComponent.getWorldMatrix());
 
 							concurrency::parallel_for_each(std::begin(group->modelList), std::end(group->modelList), [&](Group::Model const &model) -> void
 							{
@@ -629,7 +704,7 @@ namespace Gek
 							auto model = std::get<1>(entitySearch);
 
 							auto &transformComponent = entity->getComponent<Components::Transform>();
-							auto modelViewMatrix(transformComponent.getScaledMatrix() * viewMatrix);
+							auto modelViewMatrix(transformComponent.getScaledWorldMatrix() * viewMatrix);
 
 							concurrency::parallel_for_each(std::begin(model->meshList), std::end(model->meshList), [&](Group::Model::Mesh const &mesh) -> void
 							{
@@ -77,6 +77,7 @@ namespace Gek
             Plugin::Population *population = nullptr;
             Plugin::Renderer *renderer = nullptr;
             Edit::Events *events = nullptr;
+            Plugin::Option<bool> editorActive;
 
             NewtonWorld *newtonWorld = nullptr;
             void *newtonListener = nullptr;
@@ -106,6 +107,7 @@ namespace Gek
                 assert(newtonWorld);
 
                 NewtonWorldSetUserData(newtonWorld, static_cast<Newton::World *>(this));
+                editorActive.connect(core, "editor"sv, "active"sv, false);
 
                 newtonListener = NewtonWorldAddListener(newtonWorld, "__gek_pre_listener__", this);
                 assert(newtonListener);
@@ -119,11 +121,12 @@ namespace Gek
                 core->onInitialized.connect(this, &Processor::onInitialized);
                 core->onShutdown.connect(this, &Processor::onShutdown);
                 population->onReset.connect(this, &Processor::onReset);
-                population->onEntityCreated.connect(this, &Processor::onEntityCreated);
-                population->onEntityDestroyed.connect(this, &Processor::onEntityDestroyed);
-                population->onComponentAdded.connect(this, &Processor::onComponentAdded);
-                population->onComponentRemoved.connect(this, &Processor::onComponentRemoved);
+                population->onEntitiesCreated.connect(this, &Processor::onEntitiesCreated);
+                population->onEntitiesDestroyed.connect(this, &Processor::onEntitiesDestroyed);
+                population->onComponentsAdded.connect(this, &Processor::onComponentsAdded);
+                population->onComponentsRemoved.connect(this, &Processor::onComponentsRemoved);
                 population->onUpdate[50].connect(this, &Processor::onUpdate);
+                population->onUpdate[80].connect(this, &Processor::onTransformsUpdated);
                 renderer->onShowUserInterface.connect(this, &Processor::onShowUserInterface);
             }
 
@@ -146,16 +149,15 @@ namespace Gek
 
                     LockedWrite{ std::cout } << "Loading collision model: " << modelComponent.name;
 
-					static const std::vector<uint8_t> EmptyBuffer;
-                    auto filePath = getContext()->findDataPath(FileSystem::CombinePaths("physics", modelComponent.name).withExtension(".gek"));
-                    std::vector<uint8_t> buffer(FileSystem::Load(filePath, EmptyBuffer));
-					if (buffer.size() < sizeof(Header))
+                    Archive::Data file;
+                    getContext()->loadDataFile(FileSystem::CombinePaths("physics", modelComponent.name).withExtension(".gek"), file);
+                    auto header = file.getData<Header>();
+					if (!header)
 					{
 						LockedWrite{ std::cerr } << "File too small to be collision model: " << modelComponent.name;
 						return nullptr;
 					}
 
-                    Header *header = (Header *)buffer.data();
                     if (header->identifier != *(uint32_t *)"GEKX")
                     {
 						LockedWrite{ std::cerr } << "Unknown model file identifier encountered: " << modelComponent.name;
@@ -174,14 +176,15 @@ namespace Gek
 						return nullptr;
 					}
 
+                    // Newton reads the serialized collision straight from the mapped view or archive
                     struct DeSerializationData
                     {
-                        std::vector<uint8_t> &buffer;
+                        Archive::Data const &file;
                         std::size_t offset;
 
-                        DeSerializationData(std::vector<uint8_t> &buffer, uint8_t *start)
-                            : buffer(buffer)
-                            , offset(start - &buffer.at(0))
+                        DeSerializationData(Archive::Data const &file, uint8_t const *start)
+                            : file(file)
+                            , offset(start - file.data())
                         {
                         }
                     };
@@ -189,7 +192,10 @@ namespace Gek
                     auto deSerializeCollision = [](void* const serializeHandle, void* const buffer, int size) -> void
                     {
                         auto data = (DeSerializationData *)serializeHandle;
-                        memcpy(buffer, &data->buffer.at(data->offset), size);
+                        auto available = (data->offset < data->file.size() ? (data->file.size() - data->offset) : 0);
+                        auto copySize = std::min(std::size_t(size), available);
+                        memcpy(buffer, data->file.data() + data->offset, copySize);
+                        memset(static_cast<uint8_t *>(buffer) + copySize, 0, std::size_t(size) - copySize);
                         data->offset += size;
                     };
 
@@ -197,22 +203,28 @@ namespace Gek
                     {
 						LockedWrite{ std::cout } << "Loading hull collision: " << modelComponent.name;
 
-						HullHeader *hullHeader = (HullHeader *)header;
-                        DeSerializationData data(buffer, (uint8_t *)&hullHeader->serializationData[0]);
+						auto hullHeader = reinterpret_cast<HullHeader const *>(header);
+                        DeSerializationData data(file, reinterpret_cast<uint8_t const *>(&hullHeader->serializationData[0]));
                         newtonCollision = NewtonCreateCollisionFromSerialization(newtonWorld, deSerializeCollision, &data);
                     }
                     else if (header->type == 2)
                     {
 						LockedWrite{ std::cout } << "Loading tree collision: " << modelComponent.name;
 						
-						TreeHeader *treeHeader = (TreeHeader *)header;
-                        DeSerializationData data(buffer, (uint8_t *)&treeHeader->materialList[treeHeader->materialCount]);
+						auto treeHeader = file.getData<TreeHeader>();
+                        if (!treeHeader || file.size() < (sizeof(TreeHeader) + (sizeof(TreeHeader::Material) * treeHeader->materialCount)))
+                        {
+                            LockedWrite{ std::cerr } << "File too small to contain collision materials: " << modelComponent.name;
+                            return nullptr;
+                        }
+
+                        DeSerializationData data(file, reinterpret_cast<uint8_t const *>(&treeHeader->materialList[treeHeader->materialCount]));
                         newtonCollision = NewtonCreateCollisionFromSerialization(newtonWorld, deSerializeCollision, &data);
 
                         auto &surfaceMap = sceneSurfaceMap[newtonCollision];
                         for (uint32_t materialIndex = 0; materialIndex < treeHeader->materialCount; ++materialIndex)
                         {
-                            TreeHeader::Material &materialHeader = treeHeader->materialList[materialIndex];
+                            TreeHeader::Material const &materialHeader = treeHeader->materialList[materialIndex];
                             surfaceMap[materialIndex] = loadSurface(materialHeader.name);
                         }
                     }
@@ -261,24 +273,43 @@ namespace Gek
             }
 
             concurrency::critical_section criticalSection;
-            void addEntity(Plugin::Entity * const entity)
+
+            // Scene collision edits are wrapped once per batch instead of once per entity
+            void addEntities(Plugin::Population::EntityBatch const &entityBatch)
             {
-                if (entity->hasComponent<Components::Transform>())
+                concurrency::critical_section::scoped_lock lock(criticalSection);
+                const auto transformMask = population->getComponentMask<Components::Transform>();
+                const auto sceneMask = population->getComponentMask<Components::Model, Components::Scene>();
+                const auto physicalMask = population->getComponentMask<Components::Physical>();
+                const auto playerMask = population->getComponentMask<Components::Player>();
+                const auto modelMask = population->getComponentMask<Components::Model>();
+                bool sceneModified = false;
+                for (auto &entity : entityBatch)
                 {
-                    concurrency::critical_section::scoped_lock lock(criticalSection);
+                    if (!entity->hasComponentMask(transformMask))
+                    {
+                        continue;
+                    }
+
                     auto &transformComponent = entity->getComponent<Components::Transform>();
-                    if (entity->hasComponents<Components::Model, Components::Scene>())
+                    if (entity->hasComponentMask(sceneMask))
                     {
                         auto const &modelComponent = entity->getComponent<Components::Model>();
                         auto newtonCollision = loadCollision(modelComponent);
                         if (newtonCollision)
                         {
-                            createSceneCollision();
-                            NewtonSceneCollisionBeginAddRemove(newtonSceneCollision);
+                            if (!sceneModified)
+                            {
+                                createSceneCollision();
+                                NewtonSceneCollisionBeginAddRemove(newtonSceneCollision);
+                                sceneModified = true;
+                            }
+
                             auto collisionNode = NewtonSceneCollisionAddSubCollision(newtonSceneCollision, newtonCollision);
                             if (collisionNode)
                             {
-                                NewtonSceneCollisionSetSubCollisionMatrix(newtonSceneCollision, collisionNode, transformComponent.getMatrix().data);
+                                // Only a starting point, the world matrix is set again once the hierarchy has been updated
+                                NewtonSceneCollisionSetSubCollisionMatrix(newtonSceneCollision, collisionNode, transformComponent.getWorldMatrix().data);
                                 //NewtonCollisionSetScale(subCollision, transformComponent.scale.x, transformComponent.scale.y, transformComponent.scale.z);
                                 auto subCollision = NewtonSceneCollisionGetCollisionFromNode(newtonSceneCollision, collisionNode);
                                 if (subCollision)
@@ -292,15 +323,12 @@ namespace Gek
 
                                 sceneMap.insert(std::make_pair(entity, collisionNode));
                             }
-
-                            NewtonSceneCollisionEndAddRemove(newtonSceneCollision);
-                            NewtonBodySetCollision(newtonSceneBody, newtonSceneCollision);
                         }
                     }
-                    else if (entity->hasComponents<Components::Physical>())
+                    else if (entity->hasComponentMask(physicalMask))
                     {
                         auto &physicalComponent = entity->getComponent<Components::Physical>();
-                        if (entity->hasComponent<Components::Player>())
+                        if (entity->hasComponentMask(playerMask))
                         {
                             auto playerBody(createPlayerBody(core, population, newtonWorld, entity));
                             if (playerBody)
@@ -309,7 +337,7 @@ namespace Gek
                                 entityMap[entity] = std::move(playerBody);
                             }
                         }
-                        else if (entity->hasComponent<Components::Model>())
+                        else if (entity->hasComponentMask(modelMask))
                         {
                             auto const &modelComponent = entity->getComponent<Components::Model>();
                             auto newtonCollision = loadCollision(modelComponent);
@@ -325,26 +353,44 @@ namespace Gek
                         }
                     }
                 }
+
+                if (sceneModified)
+                {
+                    NewtonSceneCollisionEndAddRemove(newtonSceneCollision);
+                    NewtonBodySetCollision(newtonSceneBody, newtonSceneCollision);
+                }
             }
 
-            void removeEntity(Plugin::Entity * const entity)
+            void removeEntities(Plugin::Population::EntityBatch const &entityBatch)
             {
-                auto entitySearch = entityMap.find(entity);
-                if (entitySearch != std::end(entityMap))
+                bool sceneModified = false;
+                for (auto &entity : entityBatch)
                 {
-                    NewtonDestroyBody(entitySearch->second->getNewtonBody());
-                    auto newtonCollision = NewtonBodyGetCollision(entitySearch->second->getNewtonBody());
-                    entityMap.unsafe_erase(entitySearch);
+                    auto entitySearch = entityMap.find(entity);
+                    if (entitySearch != std::end(entityMap))
+                    {
+                        NewtonDestroyBody(entitySearch->second->getNewtonBody());
+                        entityMap.unsafe_erase(entitySearch);
+                    }
+
+                    auto sceneSearch = sceneMap.find(entity);
+                    if (sceneSearch != std::end(sceneMap))
+                    {
+                        if (!sceneModified)
+                        {
+                            NewtonSceneCollisionBeginAddRemove(newtonSceneCollision);
+                            sceneModified = true;
+                        }
+
+                        NewtonSceneCollisionRemoveSubCollision(newtonSceneCollision, sceneSearch->second);
+                        sceneMap.unsafe_erase(sceneSearch);
+                    }
                 }
 
-                auto sceneSearch = sceneMap.find(entity);
-                if (sceneSearch != std::end(sceneMap))
+                if (sceneModified)
                 {
-                    NewtonSceneCollisionBeginAddRemove(newtonSceneCollision);
-                    NewtonSceneCollisionRemoveSubCollision(newtonSceneCollision, sceneSearch->second);
                     NewtonSceneCollisionEndAddRemove(newtonSceneCollision);
                     NewtonBodySetCollision(newtonSceneBody, newtonSceneCollision);
-                    sceneMap.unsafe_erase(sceneSearch);
                 }
             }
 
@@ -370,11 +416,12 @@ namespace Gek
 
                 renderer->onShowUserInterface.disconnect(this, &Processor::onShowUserInterface);
                 population->onReset.disconnect(this, &Processor::onReset);
-                population->onEntityCreated.disconnect(this, &Processor::onEntityCreated);
-                population->onEntityDestroyed.disconnect(this, &Processor::onEntityDestroyed);
-                population->onComponentAdded.disconnect(this, &Processor::onComponentAdded);
-                population->onComponentRemoved.disconnect(this, &Processor::onComponentRemoved);
+                population->onEntitiesCreated.disconnect(this, &Processor::onEntitiesCreated);
+                population->onEntitiesDestroyed.disconnect(this, &Processor::onEntitiesDestroyed);
+                population->onComponentsAdded.disconnect(this, &Processor::onComponentsAdded);
+                population->onComponentsRemoved.disconnect(this, &Processor::onComponentsRemoved);
                 population->onUpdate[50].disconnect(this, &Processor::onUpdate);
+                population->onUpdate[80].disconnect(this, &Processor::onTransformsUpdated);
 
                 onReset();
 
@@ -395,12 +442,6 @@ namespace Gek
                         NewtonBodySetMatrix(entitySearch->second->getNewtonBody(), transformComponent.getMatrix().data);
                         NewtonBodySetCollisionScale(entitySearch->second->getNewtonBody(), transformComponent.scale.x, transformComponent.scale.y, transformComponent.scale.z);
                     }
-
-                    auto sceneSearch = sceneMap.find(entity);
-                    if (sceneSearch != std::end(sceneMap))
-                    {
-                        NewtonSceneCollisionSetSubCollisionMatrix(newtonSceneCollision, sceneSearch->second, transformComponent.getMatrix().data);
-                    }
                 }
                 else if (type == Components::Model::GetIdentifier())
                 {
@@ -441,27 +482,31 @@ namespace Gek
                 NewtonInvalidateCache(newtonWorld);
             }
 
-            void onEntityCreated(Plugin::Entity * const entity)
+            void onEntitiesCreated(Plugin::Population::EntityBatch const &entityBatch)
             {
-                addEntity(entity);
+                addEntities(entityBatch);
             }
 
-            void onEntityDestroyed(Plugin::Entity * const entity)
+            void onEntitiesDestroyed(Plugin::Population::EntityBatch const &entityBatch)
             {
-                removeEntity(entity);
+                removeEntities(entityBatch);
             }
 
-            void onComponentAdded(Plugin::Entity * const entity)
+            void onComponentsAdded(Plugin::Population::EntityBatch const &entityBatch)
             {
-                addEntity(entity);
+                addEntities(entityBatch);
             }
 
-            void onComponentRemoved(Plugin::Entity * const entity)
+            void onComponentsRemoved(Plugin::Population::EntityBatch const &entityBatch)
             {
-                if (!entity->hasComponents<Components::Transform, Components::Physical>())
+                const auto requiredMask = population->getComponentMask<Components::Transform, Components::Physical>();
+                Plugin::Population::EntityBatch removedBatch;
+                std::copy_if(std::begin(entityBatch), std::end(entityBatch), std::back_inserter(removedBatch), [requiredMask](Plugin::Entity * const entity) -> bool
                 {
-                    removeEntity(entity);
-                }
+                    return !entity->hasComponentMask(requiredMask);
+                });
+
+                removeEntities(removedBatch);
             }
 
             void onUpdate(float frameTime)
@@ -471,8 +516,7 @@ namespace Gek
 
 				GEK_PROFILER_BEGIN_SCOPE(getProfiler(), 0, 0, "Newton"sv, "Update"sv, Profiler::EmptyArguments)
 				{
-					bool editorActive = core->getOption("editor", "active").convert(false);
-					if (frameTime > 0.0f && !editorActive)
+					if (frameTime > 0.0f && !editorActive.get())
 					{
 						static constexpr float StepTime = (1.0f / 120.0f);
 						while (frameTime > 0.0f)
@@ -486,6 +530,25 @@ namespace Gek
 				} GEK_PROFILER_END_SCOPE();
             }
 
+            // Runs after the transform processor, so scene collision follows the propagated world matrices
+            // This also picks up parent moves, which never send a modified event for the child
+            void onTransformsUpdated(float frameTime)
+            {
+                if (!newtonSceneCollision)
+                {
+                    return;
+                }
+
+                for (auto &scenePair : sceneMap)
+                {
+                    auto &transformComponent = scenePair.first->getComponent<Components::Transform>();
+                    if (transformComponent.dirty)
+                    {
+                        NewtonSceneCollisionSetSubCollisionMatrix(newtonSceneCollision, scenePair.second, transformComponent.getWorldMatrix().data);
+                    }
+                }
+            }
+
             // Newton::Entity
             Plugin::Entity * const getEntity(void) const
             {
@@ -524,7 +587,12 @@ namespace Gek
                     surfaceIndexMap[hash] = 0;
 
                     JSON materialNode;
-                    materialNode.load(getContext()->findDataPath(FileSystem::CombinePaths("materials", surfaceName).withExtension(".json")));
+                    Archive::Data materialData;
+                    if (getContext()->loadDataFile(FileSystem::CombinePaths("materials", surfaceName).withExtension(".json"), materialData))
+                    {
+                        materialNode.parse(materialData.getString(), surfaceName);
+                    }
+
                     auto surfaceNode = materialNode.getMember("surface"sv);
                     if (surfaceNode.isType<JSON::Object>())
                     {
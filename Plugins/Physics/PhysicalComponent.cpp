@@ -30,6 +30,16 @@ namespace Gek
                 data->mass = evaluate(importData.getMember("mass"sv), 0.0f);
             }
 
+            void save(Components::Physical const * const data, BinaryWriter &exportData) const
+            {
+                exportData.write(data->mass);
+            }
+
+            void load(Components::Physical * const data, BinaryReader &importData)
+            {
+                importData.read(data->mass);
+            }
+
             // Edit::Component
             bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
             {
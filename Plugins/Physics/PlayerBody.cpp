@@ -5,6 +5,7 @@
 #include "GEK/API/Core.hpp"
 #include "GEK/API/ComponentMixin.hpp"
 #include "GEK/API/Population.hpp"
+#include "GEK/API/Actions.hpp"
 #include "GEK/Components/Transform.hpp"
 #include "GEK/Newton/Base.hpp"
 #include <algorithm>
@@ -92,6 +93,7 @@ namespace Gek
 		public:
             Plugin::Core *core = nullptr;
             Plugin::Population *population = nullptr;
+			Plugin::Option<bool> editorActive;
 			Newton::World *world = nullptr;
 			NewtonWorld *newtonWorld = nullptr;
 
@@ -121,6 +123,8 @@ namespace Gek
 
             bool touchingSurface = false;
 
+            static constexpr Actions::Identifier ActionList[] = { Actions::MoveForward, Actions::MoveBackward, Actions::StrafeLeft, Actions::StrafeRight, Actions::Jump, Actions::Crouch, Actions::Turn, Actions::Tilt };
+
         public:
 			PlayerBody(Plugin::Core *core,
                 Plugin::Population *population,
@@ -133,6 +137,8 @@ namespace Gek
 				, entity(entity)
 				, currentState(std::make_unique<IdleState>())
 			{
+                editorActive.connect(core, "editor"sv, "active"sv, false);
+
                 auto const &physicalComponent = entity->getComponent<Components::Physical>();
 				auto const &transformComponent = entity->getComponent<Components::Transform>();
 				auto const &playerComponent = entity->getComponent<Components::Player>();
@@ -206,12 +212,19 @@ namespace Gek
                 NewtonDestroyCollision(supportShape);
                 NewtonDestroyCollision(playerShape);
 
-                population->onAction.connect(this, &PlayerBody::onAction);
+                for (auto identifier : ActionList)
+                {
+                    population->onAction[identifier].connect(this, &PlayerBody::onAction);
+                }
             }
 
 			~PlayerBody(void)
 			{
-                population->onAction.disconnect(this, &PlayerBody::onAction);
+                for (auto identifier : ActionList)
+                {
+                    population->onAction[identifier].disconnect(this, &PlayerBody::onAction);
+                }
+
                 NewtonDestroyCollision(newtonCastingShape);
 			}
 
@@ -403,40 +416,38 @@ namespace Gek
             // Plugin::Population Slots
 			void onAction(Plugin::Population::Action const &action)
 			{
-                bool editorActive = core->getOption("editor", "active").convert(false);
-                if (editorActive)
+                if (editorActive.get())
                 {
                     return;
                 }
 
-                if (action.name == "turn")
-				{
-					headingAngle += (action.value * 0.01f);
-				}
-                else if (action.name == "tilt")
+                switch (action.identifier)
                 {
+                case Actions::Turn:
+                    headingAngle += (action.value * 0.01f);
+                    break;
+
+                case Actions::Tilt:
                     lookingAngle += (action.value * 0.01f);
                     lookingAngle = Math::Clamp(lookingAngle, -Math::Pi * 0.5f, Math::Pi * 0.5f);
-                }
-                else if (action.name == "move_forward")
-				{
-					moveForward = action.state;
-				}
-				else if (action.name == "move_backward")
-				{
-					moveBackward = action.state;
-				}
-				else if (action.name == "strafe_left")
-				{
-					strafeLeft = action.state;
-				}
-				else if (action.name == "strafe_right")
-				{
-					strafeRight = action.state;
-				}
-				else if (action.name == "crouch")
-				{
-				}
+                    break;
+
+                case Actions::MoveForward:
+                    moveForward = action.state;
+                    break;
+
+                case Actions::MoveBackward:
+                    moveBackward = action.state;
+                    break;
+
+                case Actions::StrafeLeft:
+                    strafeLeft = action.state;
+                    break;
+
+                case Actions::StrafeRight:
+                    strafeRight = action.state;
+                    break;
+                };
 
 				StatePtr nextState(currentState->onAction(this, action));
 				if (nextState)
@@ -676,29 +687,27 @@ namespace Gek
 
 		StatePtr IdleState::onAction(PlayerBody *player, Plugin::Population::Action const &action)
 		{
-			if (action.name == "crouch" && action.state)
-			{
-			}
-			else if (action.name == "move_forward" && action.state)
-			{
-				return std::make_unique<WalkingState>();
-			}
-			else if (action.name == "move_backward" && action.state)
-			{
-				return std::make_unique<WalkingState>();
-			}
-			else if (action.name == "strafe_left" && action.state)
-			{
-				return std::make_unique<WalkingState>();
-			}
-			else if (action.name == "strafe_right" && action.state)
-			{
-				return std::make_unique<WalkingState>();
-			}
-			else if (action.name == "jump" && action.state && player->touchingSurface)
-			{
-				return std::make_unique<JumpingState>();
-			}
+            if (!action.state)
+            {
+                return nullptr;
+            }
+
+            switch (action.identifier)
+            {
+            case Actions::MoveForward:
+            case Actions::MoveBackward:
+            case Actions::StrafeLeft:
+            case Actions::StrafeRight:
+                return std::make_unique<WalkingState>();
+
+            case Actions::Jump:
+                if (player->touchingSurface)
+                {
+                    return std::make_unique<JumpingState>();
+                }
+
+                break;
+            };
 
 			return nullptr;
 		}
@@ -717,7 +726,7 @@ namespace Gek
 
 		StatePtr WalkingState::onAction(PlayerBody *player, Plugin::Population::Action const &action)
 		{
-			if (action.name == "jump" && action.state && player->touchingSurface)
+			if (action.identifier == Actions::Jump && action.state && player->touchingSurface)
 			{
 				return std::make_unique<JumpingState>();
 			}
@@ -750,7 +759,7 @@ namespace Gek
 
         StatePtr JumpingState::onAction(PlayerBody *player, Plugin::Population::Action const &action)
         {
-            if (action.name == "jump" && action.state && player->touchingSurface)
+            if (action.identifier == Actions::Jump && action.state && player->touchingSurface)
             {
                 return std::make_unique<JumpingState>();
             }
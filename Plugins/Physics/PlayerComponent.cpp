@@ -43,6 +43,22 @@ namespace Gek
                 data->stairStep = evaluate(importData.getMember("stairStep"sv), 0.0f);
             }
 
+            void save(Components::Player const * const data, BinaryWriter &exportData) const
+            {
+                exportData.write(data->height);
+                exportData.write(data->outerRadius);
+                exportData.write(data->innerRadius);
+                exportData.write(data->stairStep);
+            }
+
+            void load(Components::Player * const data, BinaryReader &importData)
+            {
+                importData.read(data->height);
+                importData.read(data->outerRadius);
+                importData.read(data->innerRadius);
+                importData.read(data->stairStep);
+            }
+
             // Edit::Component
             bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
             {
@@ -2142,34 +2142,33 @@ namespace Gek
                 auto hash = GetHash(0xFFFFFFFF, filePath.getString(), flags);
                 return resourceCache.insert(hash, [this, filePath, flags, name = std::string(name)](Render::ResourceHandle handle)->CComPtr<ID3D11Resource>
                 {
-					static const std::vector<uint8_t> EmptyBuffer;
-					std::vector<uint8_t> buffer(FileSystem::Load(filePath, EmptyBuffer));
+					FileSystem::MappedFile buffer(filePath);
 
                     std::string extension(String::GetLower(filePath.getExtension()));
-                    std::function<HRESULT(const std::vector<uint8_t> &, ::DirectX::ScratchImage &)> load;
+                    std::function<HRESULT(FileSystem::MappedFile const &, ::DirectX::ScratchImage &)> load;
                     if (extension == ".dds")
                     {
-                        load = [](const std::vector<uint8_t> &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromDDSMemory(buffer.data(), buffer.size(), 0, nullptr, image); };
+                        load = [](FileSystem::MappedFile const &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromDDSMemory(buffer.data(), buffer.size(), 0, nullptr, image); };
                     }
                     else if (extension == ".tga")
                     {
-                        load = [](const std::vector<uint8_t> &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromTGAMemory(buffer.data(), buffer.size(), nullptr, image); };
+                        load = [](FileSystem::MappedFile const &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromTGAMemory(buffer.data(), buffer.size(), nullptr, image); };
                     }
                     else if (extension == ".png")
                     {
-                        load = [](const std::vector<uint8_t> &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromWICMemory(buffer.data(), buffer.size(), ::DirectX::WIC_CODEC_PNG, nullptr, image); };
+                        load = [](FileSystem::MappedFile const &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromWICMemory(buffer.data(), buffer.size(), ::DirectX::WIC_CODEC_PNG, nullptr, image); };
                     }
                     else if (extension == ".bmp")
                     {
-                        load = [](const std::vector<uint8_t> &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromWICMemory(buffer.data(), buffer.size(), ::DirectX::WIC_CODEC_BMP, nullptr, image); };
+                        load = [](FileSystem::MappedFile const &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromWICMemory(buffer.data(), buffer.size(), ::DirectX::WIC_CODEC_BMP, nullptr, image); };
                     }
                     else if (extension == ".jpg" || extension == ".jpeg")
                     {
-                        load = [](const std::vector<uint8_t> &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromWICMemory(buffer.data(), buffer.size(), ::DirectX::WIC_CODEC_JPEG, nullptr, image); };
+                        load = [](FileSystem::MappedFile const &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromWICMemory(buffer.data(), buffer.size(), ::DirectX::WIC_CODEC_JPEG, nullptr, image); };
                     }
                     else if (extension == ".tif" || extension == ".tiff")
                     {
-                        load = [](const std::vector<uint8_t> &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromWICMemory(buffer.data(), buffer.size(), ::DirectX::WIC_CODEC_TIFF, nullptr, image); };
+                        load = [](FileSystem::MappedFile const &buffer, ::DirectX::ScratchImage &image) -> HRESULT { return ::DirectX::LoadFromWICMemory(buffer.data(), buffer.size(), ::DirectX::WIC_CODEC_TIFF, nullptr, image); };
                     }
 
                     if (!load)